@@ -0,0 +1,89 @@
+/** @file
+ * Pomiar czasu odtwarzania zapisu gry ruchami wsadowymi
+ *
+ * Odtwarza ten sam losowy zapis ruchów na dwóch nowych grach: wywołując
+ * funkcję gamma_move dla każdego ruchu i jednym wywołaniem funkcji
+ * gamma_move_batch, sprawdza zgodność wyników obu odtworzeń i wypisuje
+ * średni czas ruchu. Kompilacja z katalogu głównego repozytorium:
+ *
+ *     gcc -std=c11 -O2 -I. -o batch_replay bench/batch_replay.c gamma.c
+ *
+ * Opcjonalne argumenty: bok planszy (domyślnie 4000), liczba ruchów
+ * (domyślnie 20000000) i liczba powtórzeń każdego odtworzenia (domyślnie 5),
+ * z których wypisywane jest najkrótsze.
+ */
+
+// CMake w wersji release wyłącza asercje.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "gamma.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** @brief Podaje bieżący czas w sekundach.
+ * @return Liczba sekund od ustalonej chwili.
+ */
+static double now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/** @brief Mierzy czas odtwarzania zapisu ruchów.
+ * @param[in] argc – liczba argumentów,
+ * @param[in] argv – bok planszy, liczba ruchów i liczba powtórzeń.
+ * @return Zero, gdy oba odtworzenia dały te same wyniki.
+ */
+int main(int argc, char *argv[]) {
+  uint32_t side = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 4000;
+  size_t n = (argc > 2) ? (size_t)strtoull(argv[2], NULL, 10) : 20000000;
+  gamma_move_t *moves = malloc(n * sizeof(gamma_move_t));
+  bool *results = malloc(n * sizeof(bool));
+  assert(moves != NULL && results != NULL);
+  uint64_t seed = 12345;
+  for (size_t i = 0; i < n; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    moves[i] = (gamma_move_t){1 + (uint32_t)(i % 4),
+                              (uint32_t)((seed >> 33) % side),
+                              (uint32_t)((seed >> 13) % side)};
+  }
+
+  int repeats = (argc > 3) ? atoi(argv[3]) : 5;
+  double single_time = 0;
+  double batch_time = 0;
+  size_t single = 0;
+  for (int r = 0; r < repeats; r++) {
+    gamma_t *g = gamma_new(side, side, 4, side * side);
+    assert(g != NULL);
+    single = 0;
+    double start = now();
+    for (size_t i = 0; i < n; i++)
+      single += gamma_move(g, moves[i].player, moves[i].x, moves[i].y);
+    double elapsed = now() - start;
+    if (r == 0 || elapsed < single_time)
+      single_time = elapsed;
+    uint64_t hash = gamma_hash(g);
+    gamma_delete(g);
+
+    g = gamma_new(side, side, 4, side * side);
+    assert(g != NULL);
+    start = now();
+    size_t batched = gamma_move_batch(g, moves, n, results);
+    elapsed = now() - start;
+    if (r == 0 || elapsed < batch_time)
+      batch_time = elapsed;
+    assert(batched == single && gamma_hash(g) == hash);
+    gamma_delete(g);
+  }
+
+  printf("%zu moves, %zu executed\n", n, single);
+  printf("gamma_move:       %.1f ns/move\n", single_time * 1e9 / n);
+  printf("gamma_move_batch: %.1f ns/move\n", batch_time * 1e9 / n);
+  free(moves);
+  free(results);
+  return 0;
+}
@@ -0,0 +1,69 @@
+/** @file
+ * Pomiar liczby odczytów planszy i czasu zwykłego ruchu
+ *
+ * Wykonuje losowe wywołania funkcji gamma_move dla czterech graczy
+ * i wypisuje średni czas wywołania, a w wersji skompilowanej z makrem
+ * @p GAMMA_COUNT_READS także średnią liczbę odczytów pól i rodziców pól
+ * planszy na udany ruch. Kompilacja z katalogu głównego repozytorium:
+ *
+ *     gcc -std=c11 -O2 -I. -o move_reads bench/move_reads.c gamma.c
+ *     gcc -std=c11 -O2 -DGAMMA_COUNT_READS -I. -o move_reads_count \
+ *         bench/move_reads.c gamma.c
+ *
+ * Czas należy mierzyć wersją bez zliczania odczytów. Opcjonalne argumenty:
+ * bok planszy (domyślnie 2000) i liczba wywołań (domyślnie 12000000).
+ */
+
+// CMake w wersji release wyłącza asercje.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "gamma.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** @brief Podaje bieżący czas w sekundach.
+ * @return Liczba sekund od ustalonej chwili.
+ */
+static double now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/** @brief Mierzy czas i liczbę odczytów planszy losowych ruchów.
+ * @param[in] argc – liczba argumentów,
+ * @param[in] argv – bok planszy i liczba wywołań.
+ * @return Zero.
+ */
+int main(int argc, char *argv[]) {
+  uint32_t side = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 2000;
+  uint64_t n = (argc > 2) ? strtoull(argv[2], NULL, 10) : 12000000;
+  gamma_t *g = gamma_new(side, side, 4, 2000000);
+  assert(g != NULL);
+
+  uint64_t seed = 12345;
+  uint64_t done = 0;
+  double start = now();
+  for (uint64_t i = 0; i < n; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    done += gamma_move(g, 1 + (uint32_t)(i % 4),
+                       (uint32_t)((seed >> 33) % side),
+                       (uint32_t)((seed >> 13) % side));
+  }
+  double elapsed = now() - start;
+
+  printf("%llu of %llu moves done\n", (unsigned long long)done,
+         (unsigned long long)n);
+  printf("time per call: %.1f ns\n", elapsed * 1e9 / (double)n);
+#ifdef GAMMA_COUNT_READS
+  if (done > 0)
+    printf("reads per successful move: %.1f\n",
+           (double)gamma_read_count / (double)done);
+#endif
+  gamma_delete(g);
+  return 0;
+}
@@ -0,0 +1,96 @@
+/** @file
+ * Pomiar czasu ruchów na dużej planszy w układzie kafelkowym i wierszowym
+ *
+ * Wypełnia pionkami kolejne kolumny planszy, przechodząc każdą kolumnę
+ * z góry na dół, a następnie wykonuje losowe ruchy i wypisuje średni czas
+ * ruchu w obu fazach. Przy wypełnianiu kolumn sąsiednie ruchy odczytują
+ * pola odległe o cały wiersz, więc w układzie wierszowym każdy ruch trafia
+ * na inną stronę pamięci. Pierwszy pas kolumn nie jest mierzony, by
+ * pominąć czas przydzielania stron. Kompilacja z katalogu głównego
+ * repozytorium, w układzie kafelkowym i wierszowym:
+ *
+ *     gcc -std=c11 -O2 -I. -o tiled bench/tiled_layout.c gamma.c
+ *     gcc -std=c11 -O2 -DTILED_MIN_WIDTH=UINT64_MAX -I. -o row_major \
+ *         bench/tiled_layout.c gamma.c
+ *
+ * Chybienia w TLB i pamięci podręcznej można zliczyć poleceniem
+ * perf stat -e dTLB-load-misses,cache-misses. Opcjonalne argumenty: bok
+ * planszy (domyślnie 20000), szerokość pasa kolumn (domyślnie 64) i liczba
+ * losowych ruchów (domyślnie 4000000). Pamięć dostaje tylko ta część
+ * planszy, do której sięgają ruchy.
+ */
+
+// CMake w wersji release wyłącza asercje.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "gamma.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** @brief Podaje bieżący czas w sekundach.
+ * @return Liczba sekund od ustalonej chwili.
+ */
+static double now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/** @brief Wypełnia pionkami pas kolumn planszy, kolumna po kolumnie.
+ * Co trzy kolumny zmienia się gracz, więc obaj gracze mają wiele obszarów.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] first – numer pierwszej kolumny pasa,
+ * @param[in] width – szerokość pasa,
+ * @param[in] side  – bok planszy.
+ * @return Liczba wykonanych ruchów.
+ */
+static uint64_t fill_columns(gamma_t *g, uint32_t first, uint32_t width,
+                             uint32_t side) {
+  uint64_t done = 0;
+  for (uint32_t x = first; x < first + width; x++)
+    for (uint32_t y = 0; y < side; y++)
+      done += gamma_move(g, 1 + (x / 3) % 2, x, y);
+  return done;
+}
+
+/** @brief Mierzy czas ruchów na dużej planszy.
+ * @param[in] argc – liczba argumentów,
+ * @param[in] argv – bok planszy, szerokość pasa kolumn i liczba losowych
+ *                   ruchów.
+ * @return Zero.
+ */
+int main(int argc, char *argv[]) {
+  uint32_t side = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 20000;
+  uint32_t width = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : 64;
+  uint64_t n = (argc > 3) ? strtoull(argv[3], NULL, 10) : 4000000;
+  assert(2 * (uint64_t)width <= side);
+  gamma_t *g = gamma_new(side, side, 2, UINT32_MAX);
+  assert(g != NULL);
+
+  assert(fill_columns(g, 0, width, side) == (uint64_t)width * side);
+  double start = now();
+  uint64_t done = fill_columns(g, width, width, side);
+  double elapsed = now() - start;
+  assert(done == (uint64_t)width * side);
+  printf("column fill:  %.1f ns/move\n", elapsed * 1e9 / (double)done);
+
+  uint64_t seed = 12345;
+  done = 0;
+  start = now();
+  for (uint64_t i = 0; i < n; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    done += gamma_move(g, 1 + (uint32_t)(i % 2),
+                       (uint32_t)((seed >> 33) % side),
+                       (uint32_t)((seed >> 13) % side));
+  }
+  elapsed = now() - start;
+  printf("random moves: %.1f ns/call (%llu of %llu done)\n",
+         elapsed * 1e9 / (double)n, (unsigned long long)done,
+         (unsigned long long)n);
+  gamma_delete(g);
+  return 0;
+}
@@ -6,12 +6,380 @@
  * @date 12.04.2020
  */
 
+#if defined(__linux__)
+#define _DEFAULT_SOURCE
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
 #include <stdio.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "gamma.h"
 
+/** Największa szerokość i wysokość planszy, dla której przechowywane
+ są bitmapy pól graczy */
+#define BITBOARD_MAX_SIDE 64
+
+/** Największa liczba graczy, dla której przechowywane są bitmapy
+ pól graczy */
+#define BITBOARD_MAX_PLAYERS 64
+
+/** Wyrównanie w bajtach tablic gry w jej obszarze pamięci, równe
+ rozmiarowi linii pamięci podręcznej */
+#define ARENA_ALIGNMENT 64
+
+/** Rozmiar dużej strony pamięci, o którą prosi opcja @p huge_pages */
+#define HUGE_PAGE_SIZE ((uint64_t) 2 << 20)
+
+/** Liczba pól planszy wraz z ramką, powyżej której plansza przechowywana
+ jest w trybie rzadkim, w tablicy z haszowaniem zawierającej tylko zajęte
+ pola; w trybie rzadkim przechowywana jest też plansza, na którą nie
+ udało się przydzielić pamięci w trybie gęstym */
+#define SPARSE_MIN_FIELDS ((uint64_t) 1 << 32)
+
+/** Początkowy rozmiar tablicy pól w trybie rzadkim */
+#define SPARSE_INITIAL_CAPACITY 64
+
+#ifndef TILED_MIN_WIDTH
+/** Szerokość planszy wraz z ramką, od której tablice planszy w trybie
+ gęstym przechowywane są w układzie kafelkowym; można ją nadpisać przy
+ kompilacji, np. by porównać ten układ z układem wierszowym */
+#define TILED_MIN_WIDTH 4096
+#endif
+
+/** Logarytm dwójkowy boku kwadratowego kafelka w układzie kafelkowym */
+#define TILE_SHIFT 3
+
+/** Bok kwadratowego kafelka w układzie kafelkowym; kafelek pól
+ jednobajtowych zajmuje jedną linię pamięci podręcznej */
+#define TILE_SIDE ((uint64_t) 1 << TILE_SHIFT)
+
+/** Liczba graczy, od której tablice graczy przechowywane są w trybie
+ rzadkim, tylko dla graczy, którzy wykonali już ruch */
+#define SPARSE_MIN_PLAYERS ((uint32_t) 1 << 20)
+
+/** Początkowa liczba miejsc w tablicach graczy w trybie rzadkim */
+#define PLAYERS_INITIAL_CAPACITY 16
+
+/** Największa liczba sąsiadów pola planszy, osiągana na planszy z pól
+ kwadratowych sąsiadujących także narożnikami */
+#define NEIGHBOURS 8
+
+/** Liczba pól otaczających pole planszy: pól kwadratu 3 x 3 o środku
+ w tym polu, z wyjątkiem samego pola */
+#define RING_SIZE 8
+
+/** Największa liczba pól odległych o dwa kroki od pola planszy */
+#define FAR_CELLS 16
+
+/** Największa liczba pól odległych o dwa kroki od pola planszy,
+ sąsiadujących z jednym z jego sąsiadów */
+#define FAR_MAX 5
+
+/** Największa liczba złotych ruchów, po których przebudowa struktury
+ obszarów gracza tracącego pionek może zostać odłożona */
+#define STALE_FIELDS_MAX 16
+
+/** Liczba prób odczytu, po których czekający na zakończenie zmiany stanu
+ gry wątek zaczyna oddawać procesor innym wątkom */
+#define BACKOFF_SPINS 64
+
+#if defined(__GNUC__)
+/** Zapisuje wartość elementu stanu gry odczytywanego przez inne wątki,
+ niepodzielnie i bez porządkowania względem innych operacji */
+#define STORE_SHARED(lvalue, value) \
+	__atomic_store_n(&(lvalue), (value), __ATOMIC_RELAXED)
+/** Odczytuje wartość elementu stanu gry zmienianego przez inny wątek,
+ niepodzielnie i bez porządkowania względem innych operacji */
+#define LOAD_SHARED(lvalue) __atomic_load_n(&(lvalue), __ATOMIC_RELAXED)
+#else
+/** Zapisuje wartość elementu stanu gry odczytywanego przez inne wątki */
+#define STORE_SHARED(lvalue, value) ((lvalue) = (value))
+/** Odczytuje wartość elementu stanu gry zmienianego przez inny wątek */
+#define LOAD_SHARED(lvalue) (lvalue)
+#endif
+
+#if defined(__GNUC__)
+/** Początek definicji funkcji zależnej od kształtu sąsiedztwa pól, którą
+ kompilator wstawia w kod każdego silnika gry, więc opis sąsiedztwa jest
+ w niej stałą, a pętle po sąsiadach pola mają stałą liczbę obrotów */
+#define TOPOLOGY_KERNEL static inline __attribute__((always_inline))
+/** Początek definicji rzadko wywoływanej funkcji zależnej od kształtu
+ sąsiedztwa pól, której jedna kopia służy wszystkim silnikom gry */
+#define TOPOLOGY_SHARED static __attribute__((noinline))
+#else
+/** Początek definicji funkcji zależnej od kształtu sąsiedztwa pól,
+ wstawianej w kod silników gry */
+#define TOPOLOGY_KERNEL static inline
+/** Początek definicji rzadko wywoływanej funkcji zależnej od kształtu
+ sąsiedztwa pól, wspólnej dla wszystkich silników gry */
+#define TOPOLOGY_SHARED static
+#endif
+
+#if defined(__clang__)
+/** Rozwija w całości następującą po nim pętlę po sąsiadach pola */
+#define UNROLL_NEIGHBOURS _Pragma("unroll 8")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+/** Rozwija w całości następującą po nim pętlę po sąsiadach pola */
+#define UNROLL_NEIGHBOURS _Pragma("GCC unroll 8")
+#else
+/** Rozwija pętlę po sąsiadach pola, o ile pozwala na to kompilator */
+#define UNROLL_NEIGHBOURS
+#endif
+
+#if defined(GAMMA_COUNT_READS)
+uint64_t gamma_read_count = 0;
+/** Zlicza odczyt pola lub rodzica pola planszy w zmiennej
+ @ref gamma_read_count */
+#define COUNT_READ() (gamma_read_count++)
+#else
+/** Zlicza odczyt pola lub rodzica pola planszy, tylko w wersji
+ skompilowanej z makrem @p GAMMA_COUNT_READS */
+#define COUNT_READ() ((void) 0)
+#endif
+
+/** Tablice gry umieszczane kolejno w jednym obszarze pamięci */
+enum arena_block
+{
+	ARENA_CELLS,
+	/**< Tablica @p game_array */
+	ARENA_PARENTS,
+	/**< Tablica @p parent_array */
+	ARENA_RANKS,
+	/**< Tablica @p rank_array */
+	ARENA_AREAS,
+	/**< Tablica @p areas_array */
+	ARENA_OCCUPIED,
+	/**< Tablica @p occupied_fields_array */
+	ARENA_FREE,
+	/**< Tablica @p free_neighbours */
+	ARENA_GOLDEN,
+	/**< Tablica @p golden_used */
+	ARENA_CACHE,
+	/**< Tablica @p golden_possible_cache */
+	ARENA_BITBOARDS,
+	/**< Tablica @p bitboards */
+	ARENA_ROW_SEQUENCES,
+	/**< Tablica @p row_sequences */
+	ARENA_OPEN_ROWS,
+	/**< Tablica @p open_rows */
+	ARENA_BLOCKS
+	/**< Liczba tablic */
+};
+
+/** Rodzaje wpisów w dzienniku zmian, pozwalającym cofać ruchy */
+enum undo_kind
+{
+	UNDO_MOVE,
+	/**< Początek zmian wykonanych przez jeden ruch */
+	UNDO_CELL,
+	/**< Zawartość pola planszy */
+	UNDO_PARENT,
+	/**< Rodzic pola w strukturze obszarów */
+	UNDO_RANK,
+	/**< Rząd pola w strukturze obszarów */
+	UNDO_AREAS,
+	/**< Liczba obszarów gracza */
+	UNDO_OCCUPIED,
+	/**< Liczba pól zajętych przez gracza */
+	UNDO_FREE,
+	/**< Liczba wolnych pól przyległych do pól gracza */
+	UNDO_GOLDEN,
+	/**< Informacja, czy gracz wykonał już złoty ruch */
+	UNDO_BUSY
+	/**< Liczba zajętych pól na planszy */
+};
+
+/** @struct undo_record
+ * Wpis w dzienniku zmian: poprzednia wartość zmienionego elementu stanu gry
+ */
+typedef struct undo_record
+{
+	uint64_t index;
+	/**< Numer pola lub gracza pomniejszony o 1, którego dotyczy zmiana */
+	uint64_t value;
+	/**< Wartość sprzed zmiany */
+	uint8_t kind;
+	/**< Rodzaj zmiany, jedna z wartości @ref undo_kind */
+} undo_record;
+
+/** @struct sparse_entry
+ * Pole planszy przechowywane w tablicy z haszowaniem otwartym w trybie
+ * rzadkim; pola nieobecne w tablicy są wolne i są swoimi własnymi
+ * rodzicami o rzędzie 0
+ */
+typedef struct sparse_entry
+{
+	uint64_t pos;
+	/**< Numer pola, pole ramki o numerze 0 oznacza wolne miejsce */
+	uint64_t parent;
+	/**< Rodzic pola w zapisie funkcji @ref set_parent */
+	uint32_t player;
+	/**< Numer gracza zajmującego pole lub 0, gdy pole jest wolne */
+	uint8_t rank;
+	/**< Rząd pola w strukturze obszarów */
+} sparse_entry;
+
+/** @struct player_slot
+ * Miejsce w tablicy z haszowaniem otwartym @p player_table, przyporządkowującej
+ * numerom aktywnych graczy indeksy w tablicach graczy w trybie rzadkim
+ */
+typedef struct player_slot
+{
+	uint32_t player;
+	/**< Numer gracza, 0 oznacza wolne miejsce */
+	uint32_t index;
+	/**< Indeks gracza w tablicach graczy */
+} player_slot;
+
+/** @struct stale_field
+ * Pole, z którego złoty ruch zdjął pionek gracza bez przebudowania
+ * struktury obszarów tego gracza
+ */
+typedef struct stale_field
+{
+	uint64_t pos;
+	/**< Numer pola */
+	uint32_t victim;
+	/**< Numer gracza, którego pionek został zdjęty */
+} stale_field;
+
+/** @struct adjacent_slot
+ * Miejsce w tablicy z haszowaniem otwartym zbioru @ref adjacent_set
+ */
+typedef struct adjacent_slot
+{
+	uint64_t pos;
+	/**< Numer pola, pole ramki o numerze 0 oznacza wolne miejsce */
+	uint64_t index;
+	/**< Indeks pola w tablicy @p fields zbioru */
+} adjacent_slot;
+
+/** @struct adjacent_set
+ * Zbiór wolnych pól przyległych do pól gracza. Pola przechowywane są
+ * w zwartej tablicy, co pozwala przeglądać zbiór w czasie proporcjonalnym
+ * do jego rozmiaru, a ich indeksy w tej tablicy - w tablicy z haszowaniem
+ * otwartym, co pozwala dodawać i usuwać pola w czasie stałym
+ */
+typedef struct adjacent_set
+{
+	uint64_t * fields;
+	/**< Numery pól zbioru, w dowolnej kolejności */
+	uint64_t size;
+	/**< Liczba pól w zbiorze */
+	uint64_t capacity;
+	/**< Rozmiar zaalokowanej tablicy @p fields */
+	adjacent_slot * slots;
+	/**< Tablica z haszowaniem otwartym, podająca indeksy pól */
+	uint64_t slots_capacity;
+	/**< Rozmiar tablicy @p slots, potęga dwójki */
+} adjacent_set;
+
+/** @struct area_record
+ * Opis obszaru gracza: liczba jego pól i najmniejszy prostokąt,
+ * w którym się mieści
+ */
+typedef struct area_record
+{
+	uint64_t size;
+	/**< Liczba pól obszaru */
+	uint32_t min_x;
+	/**< Najmniejszy numer kolumny pola obszaru */
+	uint32_t min_y;
+	/**< Najmniejszy numer wiersza pola obszaru */
+	uint32_t max_x;
+	/**< Największy numer kolumny pola obszaru */
+	uint32_t max_y;
+	/**< Największy numer wiersza pola obszaru */
+} area_record;
+
+/** @struct area_set
+ * Zbiór obszarów gracza. Główne pola obszarów przechowywane są w zbiorze
+ * @ref adjacent_set, a opisy obszarów - w tablicy równoległej do jego
+ * tablicy @p fields
+ */
+typedef struct area_set
+{
+	adjacent_set roots;
+	/**< Zbiór głównych pól obszarów */
+	area_record * records;
+	/**< Opisy obszarów, w kolejności pól tablicy @p fields zbioru
+	@p roots */
+	uint64_t records_capacity;
+	/**< Rozmiar zaalokowanej tablicy @p records */
+} area_set;
+
+/** @struct dfs_frame
+ * Ramka stosu przeszukiwania w głąb obszaru gracza
+ */
+typedef struct dfs_frame
+{
+	uint64_t pos;
+	/**< Numer pola */
+	uint64_t visit;
+	/**< Numer odwiedzenia pola */
+	uint64_t low;
+	/**< Najmniejszy numer odwiedzenia osiągalny z poddrzewa pola */
+	uint32_t direction;
+	/**< Numer następnego sprawdzanego sąsiada */
+	uint32_t cuts;
+	/**< Liczba poddrzew, które zostaną odcięte po zdjęciu pionka z pola */
+} dfs_frame;
+
+/** @struct scratch_header
+ * Nagłówek obszaru pomocniczego przydzielonego przez wywołującego
+ * (@p scratch w opcjach gry). Za nagłówkiem leżą kolejno stos @p area_stack,
+ * tablica @p visits i stos @p dfs_stack gry w pełnym rozmiarze. Obszar może
+ * być wspólny dla wielu gier, a w każdej z nich tablice te zaczynają się
+ * w tym samym miejscu, więc gra zeruje swoją tablicę @p visits, zanim
+ * skorzysta z obszaru po innej grze.
+ */
+typedef struct scratch_header
+{
+	const struct gamma * owner;
+	/**< Gra, która ostatnio korzystała z obszaru, lub NULL, gdy obszar
+	został przekazany nowej grze */
+} scratch_header;
+
+/** @struct engine
+ * Silnik gry: funkcje wykonujące ruchy i przeszukujące planszę,
+ * skompilowane osobno dla każdego kształtu sąsiedztwa pól makrem
+ * @ref DEFINE_ENGINE. Silnik wybierany jest raz, przy tworzeniu gry.
+ */
+typedef struct engine
+{
+	bool (*move)(gamma_t * g, uint32_t player, uint64_t pos);
+	/**< Wykonuje zwykły ruch, zob. @ref exec_move */
+	bool (*golden_move)(gamma_t * g, uint32_t player, uint64_t pos);
+	/**< Wykonuje złoty ruch, zob. @ref exec_golden */
+	size_t (*batch)(gamma_t * g, const gamma_move_t * moves, size_t n,
+												bool * results, bool golden);
+	/**< Wykonuje wsad ruchów, zob. @ref exec_batch */
+	bool (*border_target_found)(gamma_t * g, uint32_t player);
+	/**< Zob. @ref is_border_target_found */
+	uint64_t (*targets)(gamma_t * g, uint32_t player, gamma_field_t * targets,
+											uint64_t size, bool first_only);
+	/**< Wyznacza pola złotych ruchów, zob. @ref iterate_board */
+	bool (*build_adjacent_sets)(gamma_t * g);
+	/**< Zob. @ref build_adjacent_sets */
+	bool (*build_area_sets)(gamma_t * g);
+	/**< Zob. @ref build_area_sets */
+	void (*refresh_stale_areas)(gamma_t * g);
+	/**< Zob. @ref refresh_stale_areas */
+	bool (*undo)(gamma_t * g);
+	/**< Cofa ostatni ruch, zob. @ref undo_records */
+	bool (*move_effect)(gamma_t * g, uint32_t player, uint64_t pos,
+												gamma_effect_t * effect);
+	/**< Wyznacza skutki zwykłego ruchu, zob. @ref move_effect */
+	bool (*golden_effect)(gamma_t * g, uint32_t player, uint64_t pos,
+												gamma_effect_t * effect);
+	/**< Wyznacza skutki złotego ruchu, zob. @ref golden_effect */
+} engine;
 
 /** @struct gamma
  * Definicja struktury gamma
@@ -29,1061 +397,5719 @@ struct gamma
 	/**< Zmienna reprezentująca maksymalną
 	dopuszczalną liczbę rozłącznych obszarów
 	na planszy w posiadaniu gracza */
-	uint32_t * game_array;
+	gamma_topology_t topology;
+	/**< Kształt sąsiedztwa pól planszy */
+	const engine * engine;
+	/**< Silnik gry skompilowany dla kształtu sąsiedztwa pól planszy */
+	void * game_array;
 	/**< Tablica rozmiaru równego całkowitej powierzchni planszy,
+	otoczonej ramką szerokości jednego pola,
 	przechowuje stan gry, w komórce tej tablicy znajduje się 0,
 	jeśli pole o wskazanym indeksie jest wolne, w przeciwnym wypadku
-	dodatnia liczba całkowita - numer gracza zajmującego dane pole */
+	dodatnia liczba całkowita - numer gracza zajmującego dane pole;
+	jej elementy mają rozmiar @p cell_bytes */
+	uint8_t cell_bytes;
+	/**< Rozmiar w bajtach elementu tablicy @p game_array - najmniejszy,
+	w którym mieszczą się numery wszystkich graczy oraz większa od nich
+	wartość pól ramki */
 	uint32_t * areas_array;
 	/**< Tablica wymiaru @p players_count, przechowująca informację
 	 o tym, ile obszarów posiada każdy z graczy*/
 	uint64_t * occupied_fields_array;
+	/**< Tablica wymiaru @p players_count, przechowująca informację
+	 o tym, ile pól posiada każdy z graczy */
+	uint64_t * free_neighbours;
 	/**< Tablica rozmiaru równego liczbie graczy, przechowuje
 	informację ile różnych pól sąsiadujących z polami danego gracza
 	jest wolnych */
-	uint64_t * free_neighbours;
+	void * parent_array;
 	/**< Tablica rozmiaru równego całkowitej powierzchni planszy,
-	przechowuje indeks, pod którym znajduje się "rodzic" obszaru,
-	do którego przynależy dane pole */
-	uint64_t * parent_array;
+	przechowuje indeks, pod którym znajduje się "rodzic" obszaru,
+	do którego przynależy dane pole; jej elementy mają rozmiar
+	@p parent_bytes */
+	uint8_t * rank_array;
 	/**< Tablica rozmiaru równemu całkowitej powierzchni planszy,
 	przechowuje informacje o rzędach pól, wykorzystywanych
 	przy spajaniu obszarów */
-	uint64_t * rank_array;
-	/**< Tablica wymiaru @p players_count, przechowująca informację
-	 o tym, ile pól posiada każdy z graczy */
+	uint8_t parent_bytes;
+	/**< Rozmiar w bajtach elementu tablicy @p parent_array - 4, gdy
+	numery wszystkich pól mieszczą się w 32 bitach, a 8 w przeciwnym
+	wypadku */
+	uint64_t stride;
+	/**< Różnica numerów pól sąsiadujących w pionie, równa szerokości
+	planszy powiększonej o ramkę, a w układzie kafelkowym - najmniejszej
+	nie mniejszej od niej potędze dwójki */
+	uint32_t stride_shift;
+	/**< W układzie kafelkowym logarytm dwójkowy @p stride; tablice planszy
+	składają się wtedy z kwadratowych kafelków o boku @ref TILE_SIDE pól,
+	ułożonych wierszami, w których pola także ułożone są wierszami.
+	Wartość 0 oznacza układ wierszowy, w którym numer pola jest jego
+	indeksem w tablicach planszy */
 	uint64_t busy_fields_count; 	
 	/**< Zmienna reprezentująca
 	 liczbę zajętych pól na planszy gry */
-	bool * golden_moves_array;
+	bool * golden_used;
 	/**< Tablica wymiaru @p players_count, przechowująca informację,
 	 który z graczy wykonał już złoty ruch*/
+	uint64_t * area_stack;
+	/**< Stos pomocniczy, na który odkładane są pola obszaru gracza
+	tracącego pionek w wyniku złotego ruchu */
+	uint64_t area_stack_size;
+	/**< Rozmiar zaalokowanego stosu @p area_stack */
+	uint64_t board_version;
+	/**< Licznik wykonanych ruchów, zmieniający się przy każdej
+	zmianie stanu planszy */
+	uint64_t touched_low;
+	/**< Najmniejszy numer pola zajętego od utworzenia gry lub ostatniego
+	wywołania funkcji @ref gamma_reset */
+	uint64_t touched_high;
+	/**< Największy numer pola zajętego od utworzenia gry lub ostatniego
+	wywołania funkcji @ref gamma_reset; mniejszy od @p touched_low, gdy
+	żadne pole nie zostało zajęte */
+	_Atomic uint64_t sequence;
+	/**< Licznik sekwencyjny chroniący liczniki graczy przed
+	odczytem w trakcie zmiany: nieparzysty, gdy stan gry jest zmieniany.
+	Pozwala funkcjom odczytu działać równolegle z jednym wątkiem
+	wykonującym ruchy, bez blokowania go */
+	_Atomic uint64_t * row_sequences;
+	/**< W trybie gęstym tablica liczników sekwencyjnych wierszy tablic
+	planszy, po jednym na wiersz pól wraz z ramką: licznik wiersza jest
+	nieparzysty, gdy zmiana stanu gry w toku zmieniła już jakieś pole
+	tego wiersza. Pozwala odczytywać planszę wiersz po wierszu; NULL
+	w trybie rzadkim */
+	uint64_t * open_rows;
+	/**< Numery wierszy, których liczniki @p row_sequences zmiana stanu
+	gry w toku uczyniła nieparzystymi */
+	uint64_t open_rows_size;
+	/**< Liczba wierszy w tablicy @p open_rows */
+	uint64_t hash;
+	/**< Skrót Zobrista stanu gry: różnica symetryczna kluczy
+	@ref zobrist_cell zajętych pól oraz kluczy @ref zobrist_golden graczy,
+	którzy wykonali już złoty ruch */
+	uint64_t * golden_possible_cache;
+	/**< Tablica wymiaru @p players_count, przechowująca ostatnią odpowiedź
+	funkcji @ref gamma_golden_possible dla każdego z graczy wraz z numerem
+	stanu planszy, dla którego została wyznaczona */
+	uint64_t * bitboards;
+	/**< Bitmapy pól planszy, po @p height wierszy na bitmapę, bit @p x
+	wiersza @p y odpowiada polu (x,y); bitmapa 0 opisuje pola zajęte,
+	a bitmapa @p p pola gracza @p p. Przechowywane tylko dla plansz
+	o wymiarach nie większych niż @ref BITBOARD_MAX_SIDE i co najwyżej
+	@ref BITBOARD_MAX_PLAYERS graczach, w przeciwnym wypadku NULL */
+	bool undo_enabled;
+	/**< Czy zmiany wykonywane przez ruchy są zapisywane w dzienniku */
+	undo_record * undo_log;
+	/**< Dziennik zmian: poprzednie wartości zmienionych elementów stanu gry,
+	zmiany każdego ruchu poprzedzone są wpisem @ref UNDO_MOVE */
+	uint64_t undo_size;
+	/**< Liczba wpisów w dzienniku @p undo_log */
+	uint64_t undo_capacity;
+	/**< Rozmiar zaalokowanego dziennika @p undo_log */
+	adjacent_set * adjacent_sets;
+	/**< Tablica wymiaru @p players_count, przechowująca zbiory wolnych pól
+	przyległych do pól każdego z graczy. Zbiory tworzone są przy pierwszym
+	ich przeglądaniu i od tej pory aktualizowane przez każdy ruch; NULL,
+	gdy nie są utrzymywane */
+	area_set * area_sets;
+	/**< Tablica wymiaru @p players_count, przechowująca zbiory obszarów
+	każdego z graczy. Zbiory tworzone są przy pierwszym ich przeglądaniu
+	i od tej pory aktualizowane przez każdy ruch; cofnięcie ruchu lub
+	przywrócenie stanu gry je usuwa. NULL, gdy nie są utrzymywane */
+	adjacent_set * border_sets;
+	/**< Tablica wymiaru @p players_count, przechowująca zbiory pól zajętych
+	przez innych graczy, przyległych do pól każdego z graczy - jedynych pól,
+	na które może wykonać złoty ruch gracz, który nie może zająć nowego
+	obszaru. Zbiory tworzone są przy pierwszym sprawdzeniu możliwości
+	złotego ruchu takiego gracza i od tej pory aktualizowane przez każdy
+	ruch; NULL, gdy nie są utrzymywane */
+	uint64_t * visits;
+	/**< Tablica rozmiaru całkowitej powierzchni planszy, przechowująca
+	wyniki przeszukiwań obszarów funkcją @ref search_victim_area. Przydzielana
+	przy pierwszym przeszukiwaniu i nigdy nie zerowana: wpisy poprzednich
+	przeszukiwań rozpoznawane są po wartości @p visit_counter z ich początku.
+	NULL, gdy nie została jeszcze przydzielona */
+	uint64_t visit_counter;
+	/**< Liczba pól odwiedzonych przez wszystkie dotychczasowe przeszukiwania
+	obszarów funkcją @ref search_victim_area */
+	dfs_frame * dfs_stack;
+	/**< Stos przeszukiwania w głąb funkcji @ref search_victim_area,
+	wykorzystywany ponownie przez kolejne przeszukiwania */
+	uint64_t dfs_capacity;
+	/**< Rozmiar zaalokowanego stosu @p dfs_stack */
+	scratch_header * scratch;
+	/**< Obszar pomocniczy wywołującego, w którym leżą stosy @p area_stack,
+	@p dfs_stack i tablica @p visits, lub NULL, gdy przydziela je gra */
+	sparse_entry * sparse_entries;
+	/**< W trybie rzadkim tablica z haszowaniem otwartym, przechowująca
+	pola, które kiedykolwiek były zajęte, zamiast tablic @p game_array,
+	@p parent_array i @p rank_array; NULL w trybie gęstym */
+	uint64_t sparse_capacity;
+	/**< Rozmiar tablicy @p sparse_entries, potęga dwójki */
+	uint64_t sparse_size;
+	/**< Liczba pól w tablicy @p sparse_entries */
+	player_slot * player_table;
+	/**< W trybie rzadkim graczy tablica z haszowaniem otwartym rozmiaru
+	dwukrotnie większego niż @p players_capacity, podająca indeksy graczy,
+	którzy wykonali już ruch, w tablicach graczy; indeks 0 jest wspólny dla
+	pozostałych graczy, których liczniki są wyzerowane. NULL, gdy tablice
+	graczy mają wymiar @p players_count */
+	uint32_t players_active;
+	/**< Liczba graczy w tablicy @p player_table */
+	uint64_t players_capacity;
+	/**< Wymiar tablic graczy w trybie rzadkim graczy */
+	uint64_t mapped_size;
+	/**< Rozmiar obszaru pamięci gry odwzorowanego funkcją @p mmap lub 0,
+	gdy obszar został przydzielony funkcją @p calloc */
+	bool borrowed;
+	/**< Czy obszar pamięci gry przydzielił wywołujący, przekazując go
+	w opcji @p storage; obszar ten nie jest wtedy zwalniany */
+	stale_field stale_fields[STALE_FIELDS_MAX];
+	/**< Pola, wokół których struktura obszarów graczy, którym złote ruchy
+	odebrały pionki, jest nieaktualna. Struktura ta jest przebudowywana
+	dopiero przed odczytaniem obszarów jednego z tych graczy */
+	uint32_t stale_size;
+	/**< Liczba pól w tablicy @p stale_fields */
 };
 
-/** @brief Znajduje główne pole obszaru, do którego przynależy
- * pole o podanym numerze.
- * @param[in] g 				– wskaźnik na strukturę gry
- * @param[in] pos 				– numer pola
- * @return Liczba całkowita będąca numerem poszukiwanego
- * głównego pola.
+/** @brief Miesza bity numeru pola na potrzeby tablic z haszowaniem
+ * otwartym.
+ * @param[in] pos 				  – numer pola
+ * @return Wartość funkcji haszującej dla pola.
  */
-static uint64_t find_field(gamma_t * g, uint64_t pos)
+static inline uint64_t hash_field(uint64_t pos)
 {
-	if((g->parent_array)[pos] == pos)
-	{
-		return pos;
-	}
-	(g->parent_array)[pos] = find_field(g, (g->parent_array)[pos]);
-	return (g->parent_array)[pos];
+	uint64_t hash = pos * 0x9E3779B97F4A7C15ULL;
+	return hash ^ (hash >> 29);
 }
 
-/** @brief Łączy obszary, do których należą dane pola w spójny obszar.
- * @param[in] g 				  – wskaźnik na strukturę gry
- * @param[in] first_p 		 	  – numer pierwszego pola
- * @param[in] second_p 		 	  – numer drugiego pola
+/** @brief Podaje wartość zapisaną w polach ramki otaczającej planszę.
+ * Jest to największa wartość mieszcząca się w elemencie tablicy
+ * @p game_array, większa od numeru każdego z graczy.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @return Wartość pola ramki.
  */
-static void connect_fields(gamma_t * g, uint64_t first_p, uint64_t second_p)
+static inline uint64_t cell_sentinel(gamma_t * g)
 {
-	uint64_t first = find_field(g, first_p);
-	uint64_t second = find_field(g, second_p);
-	uint64_t first_rank = (g->rank_array)[first];
-	uint64_t second_rank = (g->rank_array)[second];
-	if(first_rank > second_rank)
-	{
-		(g->parent_array)[second] = first;
-	}
-	else if(first_rank < second_rank)
-	{
-		(g->parent_array)[first] = second;
-	}
-	else if(first != second)
+	if(g->cell_bytes == sizeof(uint64_t))
 	{
-		(g->parent_array)[second] = first;
-		(g->rank_array)[first]++;
+		return UINT64_MAX;
 	}
+	return ((uint64_t) 1 << (8 * g->cell_bytes)) - 1;
 }
 
-/** @brief Ustawia parametry gry gamma zgodnie z wartościami przekazanymi
- * do funkcji jako argumenty. Następnie wywołuje funkcje
- * @param[in] new_gamma 	 	  – wskaźnik na strukturę gry
- * @param[in] width 		 	  – szerokość planszy
- * @param[in] height 		 	  – wysokość planszy
- * @param[in] players 		 	  – liczba graczy
- * @param[in] areas 		 	  – maksymalna  dopuszczalna liczba 
- *							   	    obszarów należących do jednego gracza
+/** @brief Sprawdza, czy pole o podanym numerze należy do ramki
+ * otaczającej planszę.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Wartość @p true, gdy pole należy do ramki, a @p false
+ * w przeciwnym wypadku.
  */
-static void set_basic_gamma_params(gamma_t * new_gamma, uint32_t width,
-			uint32_t height, uint32_t players, uint32_t areas)
+static inline bool is_frame_field(gamma_t * g, uint64_t pos)
 {
-	new_gamma->width = width;
-	new_gamma->height = height;
-	new_gamma->players_count = players;
-	new_gamma->maximum_area_count = areas;
-	new_gamma->busy_fields_count = 0;
+	uint64_t column = pos % g->stride;
+	return (pos < g->stride || pos / g->stride > g->height
+			|| column == 0 || column > g->width);
 }
 
-/** @brief Ustawia początkowe wartości w tablicach przechowywanych
- * w strukturze gry.
- * @param[in] g 				– wskaźnik na strukturę gry
+/** @brief Podaje indeks w tablicy @p sparse_entries, pod którym znajduje
+ * się pole lub pod którym należy je umieścić.
+ * @param[in] g 				– wskaźnik na strukturę gry w trybie rzadkim
+ * @param[in] pos 				– numer pola
+ * @return Indeks w tablicy @p sparse_entries.
  */
-static void set_arrays(gamma_t * g)
+static inline uint64_t sparse_slot_of(gamma_t * g, uint64_t pos)
 {
-	uint64_t a_size = (uint64_t) g->width * (uint64_t) g->height;
-	for(uint64_t i = 0; i < a_size; i++)
-	{
-		(g->rank_array)[i] = 0;
-		(g->parent_array)[i] = i;
-		(g->game_array)[i] = 0;
-	}
-	for(uint32_t i = 0; i < g->players_count; i++)
+	uint64_t mask = g->sparse_capacity - 1;
+	uint64_t slot = hash_field(pos) & mask;
+	while((g->sparse_entries)[slot].pos != 0
+			&& (g->sparse_entries)[slot].pos != pos)
 	{
-		(g->golden_moves_array)[i] = true;
-		(g->areas_array)[i] = 0;
-		(g->free_neighbours)[i] = 0;
-		(g->occupied_fields_array)[i] = 0;
+		slot = (slot + 1) & mask;
 	}
+	return slot;
 }
 
-/** @brief Sprawdza, czy funkcja tworząca strukturę gry otrzymała
- * poprawne parametry, tj. każdy z nich jest liczbą całkowitą dodatnią.
- * @param[in] width 		 	  – szerokość planszy w tworzonej grze
- * @param[in] height 		 	  – wysokość planszy w tworzonej grze
- * @param[in] players 		 	  – liczba graczy w tworzonej grze
- * @param[in] areas 		 	  – maksymalna dopuszczalna liczba obszarów 
- *						       		do zajęcia przez jednego gracza
- * @return Wartość @p true, gdy podane parametry są podane oraz
- * wartość @p false w przeciwnym wypadku.
+/** @brief Wyszukuje pole w tablicy @p sparse_entries.
+ * @param[in] g 				– wskaźnik na strukturę gry w trybie rzadkim
+ * @param[in] pos 				– numer pola
+ * @return Wskaźnik na pole lub NULL, gdy pola nie ma w tablicy.
  */
-static bool wrong_params(uint32_t width, uint32_t height,
-						uint32_t players, uint32_t areas)
+static inline sparse_entry * sparse_find(gamma_t * g, uint64_t pos)
 {
-	return (width == 0 || height == 0
-		 || players == 0 || areas == 0);
+	sparse_entry * entry = &(g->sparse_entries)[sparse_slot_of(g, pos)];
+	return (entry->pos == pos) ? entry : NULL;
 }
 
-gamma_t * gamma_new(uint32_t width, uint32_t height,
-                   uint32_t players, uint32_t areas)
+/** @brief Wyszukuje pole w tablicy @p sparse_entries, dodając je jako
+ * wolne pole, gdy go w niej nie ma. Miejsce na pole musi zostać wcześniej
+ * zarezerwowane funkcją @ref sparse_reserve.
+ * @param[in] g 				– wskaźnik na strukturę gry w trybie rzadkim
+ * @param[in] pos 				– numer pola
+ * @return Wskaźnik na pole.
+ */
+static inline sparse_entry * sparse_insert(gamma_t * g, uint64_t pos)
 {
-	if(wrong_params(width, height, players, areas))
+	sparse_entry * entry = &(g->sparse_entries)[sparse_slot_of(g, pos)];
+	if(entry->pos != pos)
 	{
-		return NULL;
+		*entry = (sparse_entry) {pos, 0, 0, 0};
+		g->sparse_size++;
 	}
-	gamma_t * new_gamma = malloc(sizeof(gamma_t));
-	if(new_gamma == NULL)
+	return entry;
+}
+
+/** @brief Zapewnia w tablicy @p sparse_entries miejsce na kolejne pola,
+ * powiększając ją w razie potrzeby. Nic nie robi w trybie gęstym.
+ * @param[in,out] g 			– wskaźnik na strukturę gry
+ * @param[in] count 			– liczba dodawanych pól
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool sparse_reserve(gamma_t * g, uint64_t count)
+{
+	if(g->sparse_entries == NULL
+		|| 2 * (g->sparse_size + count) <= g->sparse_capacity)
 	{
-		return NULL;
+		return true;
 	}
-	set_basic_gamma_params(new_gamma, width, height, players, areas);
-	uint64_t a_size = (uint64_t) width * (uint64_t) height;
-	uint32_t * a_game_array = malloc(a_size * sizeof(uint32_t));
-	new_gamma->game_array = a_game_array;
-	if(a_game_array == NULL)
+	uint64_t new_capacity = 2 * g->sparse_capacity;
+	sparse_entry * old = g->sparse_entries;
+	uint64_t old_capacity = g->sparse_capacity;
+	g->sparse_entries = calloc(new_capacity, sizeof(sparse_entry));
+	if(g->sparse_entries == NULL)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		g->sparse_entries = old;
+		return false;
 	}
-	uint32_t * a_areas_array = malloc(players * sizeof(uint32_t));
-	new_gamma->areas_array = a_areas_array;
-	if(a_areas_array == NULL)
+	g->sparse_capacity = new_capacity;
+	for(uint64_t i = 0; i < old_capacity; i++)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		if(old[i].pos != 0)
+		{
+			(g->sparse_entries)[sparse_slot_of(g, old[i].pos)] = old[i];
+		}
 	}
-	uint64_t * a_occupied_fields_array = malloc(players * sizeof(uint64_t));
-	new_gamma->occupied_fields_array = a_occupied_fields_array;
-	if(a_occupied_fields_array == NULL)
+	free(old);
+	return true;
+}
+
+/** @brief Podaje indeks pola w tablicach planszy w trybie gęstym.
+ * W układzie kafelkowym jest to permutacja bitów numeru pola: bity wiersza
+ * kafelka pozostają na miejscu, a między bity kolumny kafelka i kolumny
+ * w kafelku wstawiane są bity wiersza w kafelku.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Indeks pola w tablicach @p game_array, @p parent_array
+ * i @p rank_array.
+ */
+static inline uint64_t storage_index(gamma_t * g, uint64_t pos)
+{
+	if(g->stride_shift == 0)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		return pos;
 	}
-	uint64_t * a_free_neighbours = malloc(players * sizeof(uint64_t));
-	new_gamma->free_neighbours = a_free_neighbours;
-	if(a_free_neighbours == NULL)
+	uint64_t column = pos & (g->stride - 1);
+	uint64_t tile_row = (pos >> g->stride_shift) & (TILE_SIDE - 1);
+	return ((pos & ~((g->stride << TILE_SHIFT) - 1))
+			| ((column & ~(TILE_SIDE - 1)) << TILE_SHIFT)
+			| (tile_row << TILE_SHIFT) | (column & (TILE_SIDE - 1)));
+}
+
+/** @brief Podaje numer gracza zajmującego pole o podanym numerze.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Numer gracza zajmującego pole, 0, gdy pole jest wolne, lub
+ * wartość @ref cell_sentinel dla pól ramki otaczającej planszę.
+ */
+static inline uint64_t get_cell(gamma_t * g, uint64_t pos)
+{
+	COUNT_READ();
+	if(g->sparse_entries != NULL)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		if(is_frame_field(g, pos))
+		{
+			return cell_sentinel(g);
+		}
+		sparse_entry * entry = sparse_find(g, pos);
+		return (entry != NULL) ? entry->player : 0;
 	}
-	uint64_t * a_parent_array = malloc(a_size * sizeof(uint64_t));
-	new_gamma->parent_array = a_parent_array;
-	if(a_parent_array == NULL)
+	pos = storage_index(g, pos);
+	switch(g->cell_bytes)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		case sizeof(uint8_t):
+		{
+			return ((uint8_t *) g->game_array)[pos];
+		}
+		case sizeof(uint16_t):
+		{
+			return ((uint16_t *) g->game_array)[pos];
+		}
+		case sizeof(uint32_t):
+		{
+			return ((uint32_t *) g->game_array)[pos];
+		}
+		default:
+		{
+			return ((uint64_t *) g->game_array)[pos];
+		}
 	}
-	uint64_t * a_rank_array = malloc(a_size * sizeof(uint64_t));
-	new_gamma->rank_array = a_rank_array;
-	if(a_rank_array == NULL)
+}
+
+/** @brief Podaje numer gracza zajmującego pole o podanym numerze
+ * w trakcie zmiany stanu gry wykonywanej przez inny wątek. W trybie gęstym
+ * odczytuje pole niepodzielnie, w trybie rzadkim tak jak @ref get_cell.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Numer gracza zajmującego pole lub 0, gdy pole jest wolne.
+ */
+static inline uint64_t read_cell(gamma_t * g, uint64_t pos)
+{
+	if(g->sparse_entries != NULL)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		return get_cell(g, pos);
 	}
-	bool * a_golden_moves_array = malloc(players * sizeof(bool));
-	new_gamma->golden_moves_array = a_golden_moves_array;
-	if(a_golden_moves_array == NULL)
+	pos = storage_index(g, pos);
+	switch(g->cell_bytes)
 	{
-		gamma_delete(new_gamma);
-		return NULL;
+		case sizeof(uint8_t):
+		{
+			return LOAD_SHARED(((uint8_t *) g->game_array)[pos]);
+		}
+		case sizeof(uint16_t):
+		{
+			return LOAD_SHARED(((uint16_t *) g->game_array)[pos]);
+		}
+		case sizeof(uint32_t):
+		{
+			return LOAD_SHARED(((uint32_t *) g->game_array)[pos]);
+		}
+		default:
+		{
+			return LOAD_SHARED(((uint64_t *) g->game_array)[pos]);
+		}
 	}
-	set_arrays(new_gamma);
-	return new_gamma;
 }
 
-void gamma_delete(gamma_t * g)
+/** @brief Czyni nieparzystym licznik @p row_sequences wiersza zawierającego
+ * pole o podanym numerze, o ile zmiana stanu gry jest w toku, a licznik
+ * jest jeszcze parzysty, i zapamiętuje wiersz w tablicy @p open_rows.
+ * Liczniki zapamiętanych wierszy na powrót czyni parzystymi funkcja
+ * @ref write_end. Nic nie robi w trybie rzadkim.
+ * @param[in,out] g 			– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer zmienianego pola
+ */
+static inline void open_row(gamma_t * g, uint64_t pos)
 {
-	if(g != NULL)
+	if(g->row_sequences == NULL
+		|| atomic_load_explicit(&g->sequence, memory_order_relaxed) % 2 == 0)
+	{
+		return;
+	}
+	uint64_t row = (g->stride_shift != 0) ? pos >> g->stride_shift
+										  : pos / g->stride;
+	_Atomic uint64_t * counter = &(g->row_sequences)[row];
+	uint64_t sequence = atomic_load_explicit(counter, memory_order_relaxed);
+	if(sequence % 2 == 0)
+	{
+		atomic_store_explicit(counter, sequence + 1, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+		(g->open_rows)[g->open_rows_size++] = row;
+	}
+}
+
+/** @brief Ustawia numer gracza zajmującego pole o podanym numerze.
+ * W trakcie zmiany stanu gry czyni najpierw nieparzystym licznik wiersza
+ * pola (patrz @ref open_row).
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @param[in] player 			– numer gracza, 0, gdy pole ma być wolne,
+ *								  lub wartość @ref cell_sentinel
+ */
+static inline void set_cell(gamma_t * g, uint64_t pos, uint64_t player)
+{
+	if(g->sparse_entries != NULL)
 	{
-		if(g->game_array == NULL)
+		sparse_entry * entry = (player == 0) ? sparse_find(g, pos)
+											 : sparse_insert(g, pos);
+		if(entry != NULL)
 		{
-			free(g);
-			return;
+			entry->player = (uint32_t) player;
+		}
+		return;
+	}
+	open_row(g, pos);
+	pos = storage_index(g, pos);
+	switch(g->cell_bytes)
+	{
+		case sizeof(uint8_t):
+		{
+			STORE_SHARED(((uint8_t *) g->game_array)[pos], (uint8_t) player);
+			break;
 		}
-		free(g->game_array);
-		if(g->areas_array == NULL)
+		case sizeof(uint16_t):
 		{
-			free(g);
-			return;
+			STORE_SHARED(((uint16_t *) g->game_array)[pos], (uint16_t) player);
+			break;
 		}
-        free(g->areas_array);
-        if(g->occupied_fields_array == NULL)
-        {
-        	free(g);
-        	return;
-        }
-        free(g->occupied_fields_array);
-        if(g->free_neighbours == NULL)
-        {
-        	free(g);
-        	return;
-        }
-        free(g->free_neighbours);
-        if(g->parent_array == NULL)
-        {
-        	free(g);
-        	return;
-        }
-		free(g->parent_array);
-		if(g->rank_array == NULL)
+		case sizeof(uint32_t):
 		{
-			free(g);
-			return;
+			STORE_SHARED(((uint32_t *) g->game_array)[pos], (uint32_t) player);
+			break;
 		}
-		free(g->rank_array);
-		if(g->golden_moves_array == NULL)
+		default:
 		{
-			free(g);
-			return;
+			STORE_SHARED(((uint64_t *) g->game_array)[pos], player);
+			break;
 		}
-        free(g->golden_moves_array);
-        free(g);
 	}
 }
 
-/** @brief Konwertuje wskazaną pozycję w postaci (x,y) do 
- * liczby całkowitej, będącej indeksem, pod którym w tablicy
- * game_array - polu w strukturze @p g znajduje się
- * wskaźnik na pole przypisane tejże pozycji (x,y).
- * @param[in] g  			 	  – wskaźnik na strukturę gry
- * @param[in] x 			 	  – numer kolumny
- * @param[in] y 			 	  – numer wiersza
- * @return Liczba całkowita - indeks, pod którym w tablicy
- * przechowującej dane o polach na planszy znajduje się pole
- * o podanych współrzędnych.
+/** @brief Podaje numer pola będącego "rodzicem" pola o podanym numerze.
+ * Wartość 0 w tablicy @p parent_array oznacza, że pole jest swoim własnym
+ * rodzicem - pole ramki o numerze 0 nie jest rodzicem żadnego innego pola.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Numer rodzica pola.
  */
-static inline uint64_t convert_pos(gamma_t * g, uint32_t x, uint32_t y)
+static inline uint64_t get_parent(gamma_t * g, uint64_t pos)
 {
-	uint64_t w = (uint64_t) g->width;
-	uint64_t target_position = w * (uint64_t) y + (uint64_t) x;
-	return target_position;
+	COUNT_READ();
+	uint64_t parent;
+	if(g->sparse_entries != NULL)
+	{
+		sparse_entry * entry = sparse_find(g, pos);
+		parent = (entry != NULL) ? entry->parent : 0;
+	}
+	else if(g->parent_bytes == sizeof(uint32_t))
+	{
+		parent = ((uint32_t *) g->parent_array)[storage_index(g, pos)];
+	}
+	else
+	{
+		parent = ((uint64_t *) g->parent_array)[storage_index(g, pos)];
+	}
+	return (parent == 0) ? pos : parent;
 }
 
-/** @brief Sprawdza, czy podane współrzędne są zgodne z
- * parametrami zapisanymi w strukturze gry.
- * @param[in] g  			 	  – wskaźnik na strukturę gry
- * @param[in] x 			 	  – numer kolumny
- * @param[in] y 			 	  – numer wiersza
- * @return Wartość @p true, jeśli podane współrzędne są poprawne dla
- * gry zapisanej w strukturze, a @p false w przeciwnym wypadku.
+/** @brief Ustawia rodzica pola o podanym numerze.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @param[in] parent 			– numer nowego rodzica pola
  */
-static inline bool check_coordinates(gamma_t * g, uint32_t x, uint32_t y)
+static inline void set_parent(gamma_t * g, uint64_t pos, uint64_t parent)
 {
-	uint32_t bound_of_x = g->width;
-	uint32_t bound_of_y = g->height;
-	return(x < bound_of_x && y < bound_of_y);
+	uint64_t stored = (parent == pos) ? 0 : parent;
+	if(g->sparse_entries != NULL)
+	{
+		sparse_entry * entry = (stored == 0) ? sparse_find(g, pos)
+											 : sparse_insert(g, pos);
+		if(entry != NULL)
+		{
+			entry->parent = stored;
+		}
+	}
+	else if(g->parent_bytes == sizeof(uint32_t))
+	{
+		((uint32_t *) g->parent_array)[storage_index(g, pos)] =
+															(uint32_t) stored;
+	}
+	else
+	{
+		((uint64_t *) g->parent_array)[storage_index(g, pos)] = stored;
+	}
+}
+
+/** @brief Podaje rząd pola o podanym numerze.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Rząd pola.
+ */
+static inline uint8_t get_rank(gamma_t * g, uint64_t pos)
+{
+	if(g->sparse_entries != NULL)
+	{
+		sparse_entry * entry = sparse_find(g, pos);
+		return (entry != NULL) ? entry->rank : 0;
+	}
+	return (g->rank_array)[storage_index(g, pos)];
+}
+
+/** @brief Ustawia rząd pola o podanym numerze.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @param[in] rank 				– nowy rząd pola
+ */
+static inline void set_rank(gamma_t * g, uint64_t pos, uint8_t rank)
+{
+	if(g->sparse_entries != NULL)
+	{
+		sparse_entry * entry = (rank == 0) ? sparse_find(g, pos)
+										   : sparse_insert(g, pos);
+		if(entry != NULL)
+		{
+			entry->rank = rank;
+		}
+		return;
+	}
+	(g->rank_array)[storage_index(g, pos)] = rank;
+}
+
+/** @brief Podaje indeks w tablicy @p player_table, pod którym znajduje
+ * się gracz lub pod którym należy go umieścić.
+ * @param[in] g 				– wskaźnik na strukturę gry w trybie rzadkim
+ *								  graczy
+ * @param[in] player 			– numer gracza
+ * @return Indeks w tablicy @p player_table.
+ */
+static inline uint64_t player_slot_of(gamma_t * g, uint64_t player)
+{
+	uint64_t mask = 2 * g->players_capacity - 1;
+	uint64_t slot = hash_field(player) & mask;
+	while((g->player_table)[slot].player != 0
+			&& (g->player_table)[slot].player != player)
+	{
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/** @brief Podaje indeks gracza w tablicach graczy.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] player 			– numer gracza
+ * @return Numer gracza pomniejszony o 1, a w trybie rzadkim graczy indeks
+ * gracza z tablicy @p player_table lub 0, gdy gracz nie wykonał
+ * jeszcze ruchu.
+ */
+static inline uint64_t player_index(gamma_t * g, uint64_t player)
+{
+	if(g->player_table == NULL)
+	{
+		return player - 1;
+	}
+	const player_slot * slot = &(g->player_table)[player_slot_of(g, player)];
+	return (slot->player == player) ? slot->index : 0;
+}
+
+/** @brief Podaje wymiar tablic graczy.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @return Liczba graczy, a w trybie rzadkim graczy liczba miejsc
+ * w tablicach graczy.
+ */
+static inline uint64_t player_slots(gamma_t * g)
+{
+	return (g->player_table == NULL) ? g->players_count : g->players_capacity;
+}
+
+/** @brief Zmienia wymiar tablic graczy w trybie rzadkim graczy. Nowe
+ * elementy tablic nie są inicjowane.
+ * @param[in,out] g 			– wskaźnik na strukturę gry
+ * @param[in] capacity 			– nowy wymiar tablic
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool resize_player_arrays(gamma_t * g, uint64_t capacity)
+{
+	uint32_t * areas = realloc(g->areas_array, capacity * sizeof(uint32_t));
+	if(areas != NULL)
+	{
+		g->areas_array = areas;
+	}
+	uint64_t * occupied = realloc(g->occupied_fields_array,
+									capacity * sizeof(uint64_t));
+	if(occupied != NULL)
+	{
+		g->occupied_fields_array = occupied;
+	}
+	uint64_t * free_fields = realloc(g->free_neighbours,
+									capacity * sizeof(uint64_t));
+	if(free_fields != NULL)
+	{
+		g->free_neighbours = free_fields;
+	}
+	bool * golden = realloc(g->golden_used, capacity * sizeof(bool));
+	if(golden != NULL)
+	{
+		g->golden_used = golden;
+	}
+	uint64_t * cache = realloc(g->golden_possible_cache,
+									capacity * sizeof(uint64_t));
+	if(cache != NULL)
+	{
+		g->golden_possible_cache = cache;
+	}
+	return (areas != NULL && occupied != NULL && free_fields != NULL
+			&& golden != NULL && cache != NULL);
+}
+
+/** @brief Zmienia rozmiar tablicy @p player_table, przenosząc do niej
+ * aktywnych graczy.
+ * @param[in,out] g 			– wskaźnik na strukturę gry w trybie rzadkim
+ *								  graczy
+ * @param[in] capacity 			– nowy wymiar tablic graczy, potęga dwójki
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool resize_player_table(gamma_t * g, uint64_t capacity)
+{
+	player_slot * old = g->player_table;
+	uint64_t old_size = 2 * g->players_capacity;
+	g->player_table = calloc(2 * capacity, sizeof(player_slot));
+	if(g->player_table == NULL)
+	{
+		g->player_table = old;
+		return false;
+	}
+	g->players_capacity = capacity;
+	for(uint64_t i = 0; i < old_size; i++)
+	{
+		if(old[i].player != 0)
+		{
+			(g->player_table)[player_slot_of(g, old[i].player)] = old[i];
+		}
+	}
+	free(old);
+	return true;
+}
+
+/** @brief Dopisuje do dziennika zmian poprzednią wartość zmienianego
+ * elementu stanu gry. Nic nie robi, gdy dziennik jest pusty - zmiany
+ * wykonane przed pierwszym zapisanym ruchem nie wymagają cofania. Gdy
+ * nie uda się powiększyć dziennika, jest on czyszczony.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] kind 				– rodzaj zmiany
+ * @param[in] index 			– numer pola lub gracza pomniejszony o 1
+ * @param[in] value 			– wartość sprzed zmiany
+ */
+static void log_change(gamma_t * g, uint8_t kind, uint64_t index, uint64_t value)
+{
+	if(g->undo_size == 0)
+	{
+		return;
+	}
+	if(g->undo_size == g->undo_capacity)
+	{
+		uint64_t new_capacity = 2 * g->undo_capacity;
+		undo_record * new_log = realloc(g->undo_log,
+										new_capacity * sizeof(undo_record));
+		if(new_log == NULL)
+		{
+			g->undo_size = 0;
+			return;
+		}
+		g->undo_log = new_log;
+		g->undo_capacity = new_capacity;
+	}
+	(g->undo_log)[g->undo_size++] = (undo_record) {index, value, kind};
+}
+
+/** @brief Rozpoczyna w dzienniku zmian zapis zmian nowego ruchu,
+ * o ile zapis zmian jest włączony.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ */
+static void log_move(gamma_t * g)
+{
+	if(!g->undo_enabled)
+	{
+		return;
+	}
+	if(g->undo_capacity == 0)
+	{
+		g->undo_log = malloc(64 * sizeof(undo_record));
+		if(g->undo_log == NULL)
+		{
+			return;
+		}
+		g->undo_capacity = 64;
+	}
+	if(g->undo_size == 0)
+	{
+		(g->undo_log)[g->undo_size++] = (undo_record) {0, 0, UNDO_MOVE};
+	}
+	else
+	{
+		log_change(g, UNDO_MOVE, 0, 0);
+	}
+}
+
+/** @brief Ustawia rodzica pola o podanym numerze, zapisując w dzienniku
+ * zmian poprzednią wartość.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @param[in] parent 			– numer nowego rodzica pola
+ */
+static inline void change_parent(gamma_t * g, uint64_t pos, uint64_t parent)
+{
+	log_change(g, UNDO_PARENT, pos, get_parent(g, pos));
+	set_parent(g, pos, parent);
+}
+
+/** @brief Ustawia rząd pola o podanym numerze, zapisując w dzienniku
+ * zmian poprzednią wartość.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @param[in] rank 				– nowy rząd pola
+ */
+static inline void change_rank(gamma_t * g, uint64_t pos, uint8_t rank)
+{
+	log_change(g, UNDO_RANK, pos, get_rank(g, pos));
+	set_rank(g, pos, rank);
+}
+
+/** @brief Zapisuje w dzienniku zmian liczniki gracza: liczbę obszarów,
+ * liczbę zajętych pól i liczbę wolnych pól przyległych do jego pól.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] player 			– numer gracza
+ */
+static void log_player(gamma_t * g, uint32_t player)
+{
+	uint64_t index = player_index(g, player);
+	log_change(g, UNDO_AREAS, player - 1, (g->areas_array)[index]);
+	log_change(g, UNDO_OCCUPIED, player - 1, (g->occupied_fields_array)[index]);
+	log_change(g, UNDO_FREE, player - 1, (g->free_neighbours)[index]);
+}
+
+/** @brief Znajduje główne pole obszaru, do którego przynależy
+ * pole o podanym numerze. Skraca przy tym ścieżkę, podpinając
+ * co drugie odwiedzone pole pod jego dziadka.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Liczba całkowita będąca numerem poszukiwanego
+ * głównego pola.
+ */
+static uint64_t find_field(gamma_t * g, uint64_t pos)
+{
+	uint64_t parent = get_parent(g, pos);
+	while(parent != pos)
+	{
+		uint64_t grandparent = get_parent(g, parent);
+		change_parent(g, pos, grandparent);
+		pos = grandparent;
+		parent = get_parent(g, pos);
+	}
+	return pos;
+}
+
+/** @brief Łączy dwa obszary o podanych głównych polach, podpinając
+ * obszar o niższym rzędzie pod obszar o wyższym rzędzie.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @param[in] first 		 	  – główne pole pierwszego obszaru
+ * @param[in] second 		 	  – główne pole drugiego obszaru
+ * @return Numer głównego pola połączonego obszaru.
+ */
+static uint64_t link_roots(gamma_t * g, uint64_t first, uint64_t second)
+{
+	uint8_t first_rank = get_rank(g, first);
+	uint8_t second_rank = get_rank(g, second);
+	if(first_rank > second_rank)
+	{
+		change_parent(g, second, first);
+		return first;
+	}
+	else if(first_rank < second_rank)
+	{
+		change_parent(g, first, second);
+		return second;
+	}
+	else if(first != second)
+	{
+		change_parent(g, second, first);
+		change_rank(g, first, first_rank + 1);
+	}
+	return first;
+}
+
+/** @brief Łączy obszary, do których należą dane pola w spójny obszar.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @param[in] first_p 		 	  – numer pierwszego pola
+ * @param[in] second_p 		 	  – numer drugiego pola
+ */
+static void connect_fields(gamma_t * g, uint64_t first_p, uint64_t second_p)
+{
+	link_roots(g, find_field(g, first_p), find_field(g, second_p));
+}
+
+/** @brief Miesza bity liczby bijekcją z generatora splitmix64.
+ * @param[in] value 			  – mieszana liczba
+ * @return Liczba o wymieszanych bitach.
+ */
+static inline uint64_t mix_bits(uint64_t value)
+{
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+/** @brief Podaje klucz Zobrista pola zajętego przez gracza. Klucze nie są
+ * przechowywane w tablicy, lecz wyznaczane przy każdym użyciu z numeru pola
+ * i gracza, więc nie zajmują pamięci niezależnie od rozmiaru planszy.
+ * @param[in] pos 				  – numer pola
+ * @param[in] player 			  – numer gracza lub 0 dla wolnego pola
+ * @return Klucz pola, 0 dla wolnego pola.
+ */
+static inline uint64_t zobrist_cell(uint64_t pos, uint64_t player)
+{
+	if(player == 0)
+	{
+		return 0;
+	}
+	return mix_bits(mix_bits(pos + 0x9E3779B97F4A7C15ULL) + player);
+}
+
+/** @brief Podaje klucz Zobrista gracza, który wykonał już złoty ruch.
+ * @param[in] player 			  – numer gracza
+ * @return Klucz gracza.
+ */
+static inline uint64_t zobrist_golden(uint64_t player)
+{
+	return mix_bits(player ^ 0xD6E8FEB86659FD93ULL);
+}
+
+/** @brief Podaje indeks w tablicy @p slots zbioru, pod którym znajduje się
+ * pole lub pod którym należy je umieścić.
+ * @param[in] set 				  – wskaźnik na zbiór
+ * @param[in] pos 				  – numer pola
+ * @return Indeks w tablicy @p slots.
+ */
+static uint64_t adjacent_slot_of(const adjacent_set * set, uint64_t pos)
+{
+	uint64_t mask = set->slots_capacity - 1;
+	uint64_t slot = hash_field(pos) & mask;
+	while((set->slots)[slot].pos != 0 && (set->slots)[slot].pos != pos)
+	{
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/** @brief Zapewnia w zbiorze miejsce na kolejne pole, powiększając
+ * w razie potrzeby obie jego tablice.
+ * @param[in,out] set 			  – wskaźnik na zbiór
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool adjacent_set_reserve(adjacent_set * set)
+{
+	if(set->size == set->capacity)
+	{
+		uint64_t new_capacity = (set->capacity == 0) ? 8 : 2 * set->capacity;
+		uint64_t * new_fields = realloc(set->fields,
+										new_capacity * sizeof(uint64_t));
+		if(new_fields == NULL)
+		{
+			return false;
+		}
+		set->fields = new_fields;
+		set->capacity = new_capacity;
+	}
+	if(2 * (set->size + 1) > set->slots_capacity)
+	{
+		uint64_t new_capacity = (set->slots_capacity == 0)
+										? 16 : 2 * set->slots_capacity;
+		adjacent_slot * new_slots = calloc(new_capacity, sizeof(adjacent_slot));
+		if(new_slots == NULL)
+		{
+			return false;
+		}
+		free(set->slots);
+		set->slots = new_slots;
+		set->slots_capacity = new_capacity;
+		for(uint64_t i = 0; i < set->size; i++)
+		{
+			uint64_t pos = (set->fields)[i];
+			(set->slots)[adjacent_slot_of(set, pos)] = (adjacent_slot) {pos, i};
+		}
+	}
+	return true;
+}
+
+/** @brief Dodaje pole do zbioru, o ile jeszcze do niego nie należy.
+ * @param[in,out] set 			  – wskaźnik na zbiór
+ * @param[in] pos 				  – numer pola, różny od 0
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool adjacent_set_add(adjacent_set * set, uint64_t pos)
+{
+	if(set->slots_capacity != 0
+			&& (set->slots)[adjacent_slot_of(set, pos)].pos == pos)
+	{
+		return true;
+	}
+	if(!adjacent_set_reserve(set))
+	{
+		return false;
+	}
+	(set->slots)[adjacent_slot_of(set, pos)] = (adjacent_slot) {pos, set->size};
+	(set->fields)[set->size++] = pos;
+	return true;
+}
+
+/** @brief Usuwa pole ze zbioru, o ile do niego należy. Na zwolnione
+ * miejsce tablicy @p fields przenoszone jest ostatnie pole, a luka
+ * w tablicy @p slots wypełniana jest przez przesuwanie kolejnych pól
+ * w tył, dzięki czemu tablica nie wymaga znaczników usuniętych pól.
+ * @param[in,out] set 			  – wskaźnik na zbiór
+ * @param[in] pos 				  – numer pola
+ */
+static void adjacent_set_remove(adjacent_set * set, uint64_t pos)
+{
+	if(set->slots_capacity == 0)
+	{
+		return;
+	}
+	uint64_t hole = adjacent_slot_of(set, pos);
+	if((set->slots)[hole].pos != pos)
+	{
+		return;
+	}
+	uint64_t index = (set->slots)[hole].index;
+	uint64_t last = (set->fields)[--set->size];
+	if(last != pos)
+	{
+		(set->fields)[index] = last;
+		(set->slots)[adjacent_slot_of(set, last)].index = index;
+	}
+	uint64_t mask = set->slots_capacity - 1;
+	uint64_t next = (hole + 1) & mask;
+	while((set->slots)[next].pos != 0)
+	{
+		uint64_t home = hash_field((set->slots)[next].pos) & mask;
+		if(((next - home) & mask) >= ((next - hole) & mask))
+		{
+			(set->slots)[hole] = (set->slots)[next];
+			hole = next;
+		}
+		next = (next + 1) & mask;
+	}
+	(set->slots)[hole].pos = 0;
+}
+
+/** @brief Zwalnia tablicę zbiorów pól, po jednym dla każdego gracza,
+ * i ustawia wskaźnik na nią na NULL.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @param[in,out] sets 			  – wskaźnik na tablicę zbiorów lub na NULL
+ */
+static void free_field_sets(gamma_t * g, adjacent_set ** sets)
+{
+	if(*sets == NULL)
+	{
+		return;
+	}
+	for(uint64_t i = 0; i < player_slots(g); i++)
+	{
+		free((*sets)[i].fields);
+		free((*sets)[i].slots);
+	}
+	free(*sets);
+	*sets = NULL;
+}
+
+/** @brief Opróżnia zbiór pól, zachowując jego tablice.
+ * @param[in,out] set 			  – wskaźnik na zbiór
+ */
+static void clear_field_set(adjacent_set * set)
+{
+	set->size = 0;
+	if(set->slots != NULL)
+	{
+		memset(set->slots, 0, set->slots_capacity * sizeof(adjacent_slot));
+	}
+}
+
+/** @brief Usuwa zbiory wolnych pól przyległych do pól graczy; od tej
+ * pory nie są one utrzymywane, dopóki nie zostaną ponownie utworzone.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ */
+static void drop_adjacent_sets(gamma_t * g)
+{
+	free_field_sets(g, &g->adjacent_sets);
+}
+
+/** @brief Usuwa zbiory pól innych graczy przyległych do pól graczy; od tej
+ * pory nie są one utrzymywane, dopóki nie zostaną ponownie utworzone.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ */
+static void drop_border_sets(gamma_t * g)
+{
+	free_field_sets(g, &g->border_sets);
+}
+
+/** @brief Usuwa zbiory obszarów graczy; od tej pory nie są one
+ * utrzymywane, dopóki nie zostaną ponownie utworzone.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ */
+static void drop_area_sets(gamma_t * g)
+{
+	if(g->area_sets == NULL)
+	{
+		return;
+	}
+	for(uint64_t i = 0; i < player_slots(g); i++)
+	{
+		free((g->area_sets)[i].roots.fields);
+		free((g->area_sets)[i].roots.slots);
+		free((g->area_sets)[i].records);
+	}
+	free(g->area_sets);
+	g->area_sets = NULL;
+}
+
+/** @brief Wyznacza opis obszaru złożonego z jednego pola.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @param[in] pos 				  – numer pola
+ * @return Opis obszaru.
+ */
+static inline area_record single_area(gamma_t * g, uint64_t pos)
+{
+	uint32_t x = (uint32_t) (pos % g->stride - 1);
+	uint32_t y = (uint32_t) (pos / g->stride - 1);
+	return (area_record) {1, x, y, x, y};
+}
+
+/** @brief Dołącza obszar do opisu innego obszaru.
+ * @param[in,out] area 			  – wskaźnik na opis obszaru
+ * @param[in] other 			  – opis dołączanego obszaru
+ */
+static inline void merge_area(area_record * area, area_record other)
+{
+	area->size += other.size;
+	area->min_x = (other.min_x < area->min_x) ? other.min_x : area->min_x;
+	area->min_y = (other.min_y < area->min_y) ? other.min_y : area->min_y;
+	area->max_x = (other.max_x > area->max_x) ? other.max_x : area->max_x;
+	area->max_y = (other.max_y > area->max_y) ? other.max_y : area->max_y;
+}
+
+/** @brief Podaje wskaźnik na opis obszaru o podanym głównym polu.
+ * @param[in] set 				  – wskaźnik na zbiór obszarów
+ * @param[in] root 				  – główne pole obszaru
+ * @return Wskaźnik na opis obszaru lub NULL, gdy obszaru nie ma w zbiorze.
+ */
+static area_record * find_area(area_set * set, uint64_t root)
+{
+	if(set->roots.slots_capacity == 0)
+	{
+		return NULL;
+	}
+	adjacent_slot slot = (set->roots.slots)[adjacent_slot_of(&set->roots, root)];
+	return (slot.pos == root) ? &(set->records)[slot.index] : NULL;
+}
+
+/** @brief Usuwa obszar ze zbioru, przenosząc opis ostatniego obszaru
+ * na zwolnione miejsce, tak jak robi to funkcja @ref adjacent_set_remove.
+ * @param[in,out] set 			  – wskaźnik na zbiór obszarów
+ * @param[in] root 				  – główne pole obszaru
+ * @param[out] area 			  – wskaźnik na opis usuniętego obszaru
+ * @return Wartość @p true, gdy obszar należał do zbioru, a @p false
+ * w przeciwnym wypadku.
+ */
+static bool take_area(area_set * set, uint64_t root, area_record * area)
+{
+	area_record * found = find_area(set, root);
+	if(found == NULL)
+	{
+		return false;
+	}
+	*area = *found;
+	*found = (set->records)[set->roots.size - 1];
+	adjacent_set_remove(&set->roots, root);
+	return true;
+}
+
+/** @brief Dodaje obszar do zbioru.
+ * @param[in,out] set 			  – wskaźnik na zbiór obszarów
+ * @param[in] root 				  – główne pole obszaru, nienależące
+ *									do zbioru
+ * @param[in] area 				  – opis obszaru
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool put_area(area_set * set, uint64_t root, area_record area)
+{
+	if(!adjacent_set_add(&set->roots, root))
+	{
+		return false;
+	}
+	if(set->records_capacity < set->roots.capacity)
+	{
+		area_record * records = realloc(set->records,
+							set->roots.capacity * sizeof(area_record));
+		if(records == NULL)
+		{
+			return false;
+		}
+		set->records = records;
+		set->records_capacity = set->roots.capacity;
+	}
+	(set->records)[set->roots.size - 1] = area;
+	return true;
+}
+
+/** @brief Aktualizuje zbiór obszarów gracza, który zajął pole @p pos,
+ * łącząc obszary o głównych polach z tablicy @p roots w jeden obszar
+ * o głównym polu @p root. Nic nie robi, gdy zbiory obszarów nie są
+ * utrzymywane; gdy nie uda się zaalokować pamięci, przestają być
+ * utrzymywane.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @param[in] player 			  – numer gracza
+ * @param[in] pos 				  – numer zajętego pola
+ * @param[in] roots 			  – główne pola łączonych obszarów
+ * @param[in] roots_size 		  – liczba łączonych obszarów
+ * @param[in] root 				  – główne pole połączonego obszaru
+ */
+static void join_areas(gamma_t * g, uint32_t player, uint64_t pos,
+					const uint64_t roots[], uint32_t roots_size, uint64_t root)
+{
+	if(g->area_sets == NULL)
+	{
+		return;
+	}
+	area_set * set = &(g->area_sets)[player_index(g, player)];
+	area_record joined = single_area(g, pos);
+	for(uint32_t i = 0; i < roots_size; i++)
+	{
+		area_record area;
+		if(take_area(set, roots[i], &area))
+		{
+			merge_area(&joined, area);
+		}
+	}
+	if(!put_area(set, root, joined))
+	{
+		drop_area_sets(g);
+	}
+}
+
+/** @brief Zmienia wymiar tablic graczy w trybie rzadkim graczy, razem
+ * z tablicą @p player_table i zbiorami @p adjacent_sets, @p area_sets
+ * oraz @p border_sets.
+ * Nowe zbiory są puste, a pozostałe nowe elementy tablic graczy nie są inicjowane.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry w trybie
+ *									rzadkim graczy
+ * @param[in] capacity 			  – nowy wymiar tablic, nie mniejszy
+ *									od dotychczasowego
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool grow_players(gamma_t * g, uint64_t capacity)
+{
+	if(!resize_player_arrays(g, capacity))
+	{
+		return false;
+	}
+	if(g->adjacent_sets != NULL)
+	{
+		adjacent_set * sets = realloc(g->adjacent_sets,
+									capacity * sizeof(adjacent_set));
+		if(sets == NULL)
+		{
+			drop_adjacent_sets(g);
+		}
+		else
+		{
+			memset(sets + g->players_capacity, 0,
+				(capacity - g->players_capacity) * sizeof(adjacent_set));
+			g->adjacent_sets = sets;
+		}
+	}
+	if(g->area_sets != NULL)
+	{
+		area_set * sets = realloc(g->area_sets, capacity * sizeof(area_set));
+		if(sets == NULL)
+		{
+			drop_area_sets(g);
+		}
+		else
+		{
+			memset(sets + g->players_capacity, 0,
+				(capacity - g->players_capacity) * sizeof(area_set));
+			g->area_sets = sets;
+		}
+	}
+	if(g->border_sets != NULL)
+	{
+		adjacent_set * sets = realloc(g->border_sets,
+									capacity * sizeof(adjacent_set));
+		if(sets == NULL)
+		{
+			drop_border_sets(g);
+		}
+		else
+		{
+			memset(sets + g->players_capacity, 0,
+				(capacity - g->players_capacity) * sizeof(adjacent_set));
+			g->border_sets = sets;
+		}
+	}
+	if(capacity == g->players_capacity)
+	{
+		return true;
+	}
+	if(!resize_player_table(g, capacity))
+	{
+		drop_adjacent_sets(g);
+		drop_area_sets(g);
+		drop_border_sets(g);
+		return false;
+	}
+	return true;
+}
+
+/** @brief Zapewnia graczowi w trybie rzadkim graczy własny indeks
+ * w tablicach graczy, z wyzerowanymi licznikami. Nic nie robi w trybie
+ * gęstym graczy lub gdy gracz ma już indeks.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ * @param[in] player 			  – numer gracza
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool ensure_player(gamma_t * g, uint32_t player)
+{
+	if(g->player_table == NULL || player_index(g, player) != 0)
+	{
+		return true;
+	}
+	if(g->players_active + 1 == g->players_capacity
+		&& !grow_players(g, 2 * g->players_capacity))
+	{
+		return false;
+	}
+	uint32_t index = ++g->players_active;
+	(g->areas_array)[index] = 0;
+	(g->occupied_fields_array)[index] = 0;
+	(g->free_neighbours)[index] = 0;
+	(g->golden_used)[index] = false;
+	(g->golden_possible_cache)[index] = 0;
+	(g->player_table)[player_slot_of(g, player)] =
+										(player_slot) {player, index};
+	return true;
+}
+
+/** @brief Ustawia parametry gry gamma zgodnie z wartościami przekazanymi
+ * do funkcji jako argumenty. Następnie wywołuje funkcje
+ * @param[in] new_gamma 	 	  – wskaźnik na strukturę gry
+ * @param[in] width 		 	  – szerokość planszy
+ * @param[in] height 		 	  – wysokość planszy
+ * @param[in] players 		 	  – liczba graczy
+ * @param[in] areas 		 	  – maksymalna  dopuszczalna liczba 
+ *							   	    obszarów należących do jednego gracza
+ */
+static void set_basic_gamma_params(gamma_t * new_gamma, uint32_t width,
+			uint32_t height, uint32_t players, uint32_t areas)
+{
+	new_gamma->width = width;
+	new_gamma->height = height;
+	new_gamma->players_count = players;
+	new_gamma->maximum_area_count = areas;
+	new_gamma->topology = GAMMA_TOPOLOGY_SQUARE;
+	new_gamma->engine = NULL;
+	new_gamma->busy_fields_count = 0;
+	new_gamma->stride = (uint64_t) width + 2;
+	new_gamma->stride_shift = 0;
+	new_gamma->area_stack = NULL;
+	new_gamma->area_stack_size = 0;
+	new_gamma->board_version = 1;
+	new_gamma->touched_low = UINT64_MAX;
+	new_gamma->touched_high = 0;
+	atomic_init(&new_gamma->sequence, 0);
+	new_gamma->hash = 0;
+	new_gamma->bitboards = NULL;
+	new_gamma->undo_enabled = false;
+	new_gamma->undo_log = NULL;
+	new_gamma->undo_size = 0;
+	new_gamma->undo_capacity = 0;
+	new_gamma->adjacent_sets = NULL;
+	new_gamma->area_sets = NULL;
+	new_gamma->border_sets = NULL;
+	new_gamma->visits = NULL;
+	new_gamma->visit_counter = 0;
+	new_gamma->dfs_stack = NULL;
+	new_gamma->dfs_capacity = 0;
+	new_gamma->scratch = NULL;
+	new_gamma->sparse_entries = NULL;
+	new_gamma->sparse_capacity = 0;
+	new_gamma->sparse_size = 0;
+	new_gamma->player_table = NULL;
+	new_gamma->players_active = 0;
+	new_gamma->players_capacity = 0;
+	new_gamma->mapped_size = 0;
+	new_gamma->borrowed = false;
+	new_gamma->stale_size = 0;
+	new_gamma->row_sequences = NULL;
+	new_gamma->open_rows = NULL;
+	new_gamma->open_rows_size = 0;
+}
+
+/** @brief Rozpoczyna zmianę stanu gry, czyniąc licznik @p sequence
+ * nieparzystym, o ile zmiana nie jest już w toku. Wywoływana wyłącznie
+ * przez wątek wykonujący ruchy.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ * @return Wartość @p true, gdy rozpoczęto zmianę, a @p false, gdy była
+ * ona już w toku.
+ */
+static inline bool write_begin(gamma_t * g)
+{
+	uint64_t sequence = atomic_load_explicit(&g->sequence, memory_order_relaxed);
+	if(sequence % 2 == 1)
+	{
+		return false;
+	}
+	atomic_store_explicit(&g->sequence, sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	return true;
+}
+
+/** @brief Kończy zmianę stanu gry rozpoczętą funkcją @ref write_begin,
+ * czyniąc z powrotem parzystymi liczniki wierszy, w których zmieniono pola,
+ * i licznik @p sequence.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ * @param[in] begun 			  – wynik funkcji @ref write_begin
+ */
+static inline void write_end(gamma_t * g, bool begun)
+{
+	if(begun)
+	{
+		for(uint64_t i = 0; i < g->open_rows_size; i++)
+		{
+			_Atomic uint64_t * counter = &(g->row_sequences)[(g->open_rows)[i]];
+			uint64_t sequence = atomic_load_explicit(counter,
+													memory_order_relaxed);
+			atomic_store_explicit(counter, sequence + 1, memory_order_release);
+		}
+		g->open_rows_size = 0;
+		uint64_t sequence = atomic_load_explicit(&g->sequence,
+													memory_order_relaxed);
+		atomic_store_explicit(&g->sequence, sequence + 1, memory_order_release);
+	}
+}
+
+/** @brief Czeka chwilę na zakończenie zmiany stanu gry wykonywanej przez
+ * inny wątek: przez pierwsze @ref BACKOFF_SPINS prób tylko wstrzymuje
+ * procesor, a później oddaje go innym wątkom.
+ * @param[in,out] attempts 		  – liczba dotychczasowych prób
+ */
+static inline void back_off(uint32_t * attempts)
+{
+	if(*attempts < BACKOFF_SPINS)
+	{
+		(*attempts)++;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_ia32_pause();
+#endif
+	}
+	else
+	{
+#if defined(__linux__)
+		sched_yield();
+#endif
+	}
+}
+
+/** @brief Rozpoczyna odczyt chroniony licznikiem sekwencyjnym, czekając
+ * na zakończenie zmiany, która jest w toku.
+ * @param[in] counter 			  – wskaźnik na licznik @p sequence gry
+ *									lub licznik wiersza z tablicy
+ *									@p row_sequences
+ * @return Parzysta wartość licznika na początku odczytu.
+ */
+static inline uint64_t read_begin(_Atomic uint64_t * counter)
+{
+	uint32_t attempts = 0;
+	uint64_t sequence = atomic_load_explicit(counter, memory_order_acquire);
+	while(sequence % 2 == 1)
+	{
+		back_off(&attempts);
+		sequence = atomic_load_explicit(counter, memory_order_acquire);
+	}
+	return sequence;
+}
+
+/** @brief Sprawdza, czy odczyt rozpoczęty funkcją @ref read_begin trzeba
+ * powtórzyć, bo w jego trakcie chronione licznikiem dane się zmieniły.
+ * @param[in] counter 			  – wskaźnik na licznik z wywołania
+ *									@ref read_begin
+ * @param[in] sequence 			  – wynik funkcji @ref read_begin
+ * @return Wartość @p true, gdy odczyt należy powtórzyć, a @p false
+ * w przeciwnym wypadku.
+ */
+static inline bool read_retry(_Atomic uint64_t * counter, uint64_t sequence)
+{
+	atomic_thread_fence(memory_order_acquire);
+	return (atomic_load_explicit(counter, memory_order_relaxed) != sequence);
+}
+
+/** @brief Ustawia w tablicy @p game_array wartość @ref cell_sentinel
+ * pól ramki otaczającej planszę. Początkowy stan pozostałych elementów
+ * wszystkich tablic gry składa się z samych zer: pola są wolne, każde pole
+ * jest swoim własnym rodzicem, a liczniki graczy są wyzerowane. W trybie
+ * rzadkim pola ramki rozpoznawane są na podstawie numeru pola.
+ * Ustawia jedynie pola ramki w wierszach tablic planszy o numerach
+ * od @p first do @p last - 1.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] first 			– numer pierwszego wiersza
+ * @param[in] last 				– numer wiersza następnego po ostatnim
+ */
+static void set_frame_rows(gamma_t * g, uint64_t first, uint64_t last)
+{
+	if(g->sparse_entries != NULL)
+	{
+		return;
+	}
+	uint64_t sentinel = cell_sentinel(g);
+	uint64_t rows = (uint64_t) g->height + 2;
+	for(uint64_t row = first; row < last && row < rows; row++)
+	{
+		uint64_t start = row * g->stride;
+		if(row == 0 || row == rows - 1)
+		{
+			for(uint64_t i = 0; i < g->stride; i++)
+			{
+				set_cell(g, start + i, sentinel);
+			}
+		}
+		else
+		{
+			set_cell(g, start, sentinel);
+			set_cell(g, start + g->width + 1, sentinel);
+		}
+	}
+}
+
+/** @brief Ustawia wartości pól ramki otaczającej planszę.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ */
+static void set_frame(gamma_t * g)
+{
+	set_frame_rows(g, 0, (uint64_t) g->height + 2);
+}
+
+/** @brief Sprawdza, czy funkcja tworząca strukturę gry otrzymała
+ * poprawne parametry, tj. każdy z nich jest liczbą całkowitą dodatnią.
+ * @param[in] width 		 	  – szerokość planszy w tworzonej grze
+ * @param[in] height 		 	  – wysokość planszy w tworzonej grze
+ * @param[in] players 		 	  – liczba graczy w tworzonej grze
+ * @param[in] areas 		 	  – maksymalna dopuszczalna liczba obszarów 
+ *						       		do zajęcia przez jednego gracza
+ * @return Wartość @p true, gdy podane parametry są podane oraz
+ * wartość @p false w przeciwnym wypadku.
+ */
+static bool wrong_params(uint32_t width, uint32_t height,
+						uint32_t players, uint32_t areas)
+{
+	return (width == 0 || height == 0
+		 || players == 0 || areas == 0);
+}
+
+/** @brief Wybiera układ kafelkowy tablic planszy dla plansz o szerokości
+ * wraz z ramką co najmniej @ref TILED_MIN_WIDTH, jeśli plansza
+ * w tym układzie mieści się w trybie gęstym. W układzie wierszowym pola
+ * sąsiadujące w pionie leżą w różnych liniach pamięci podręcznej, a na
+ * szerokich planszach także na różnych stronach pamięci.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ */
+static void set_layout(gamma_t * g)
+{
+	uint64_t width = (uint64_t) g->width + 2;
+	uint32_t shift = TILE_SHIFT;
+	while(((uint64_t) 1 << shift) < width)
+	{
+		shift++;
+	}
+	uint64_t rows = ((uint64_t) g->height + 2 + TILE_SIDE - 1)
+											& ~(TILE_SIDE - 1);
+	if(width >= TILED_MIN_WIDTH && rows <= (SPARSE_MIN_FIELDS >> shift))
+	{
+		g->stride = (uint64_t) 1 << shift;
+		g->stride_shift = shift;
+	}
+}
+
+/** @brief Podaje rozmiar tablic planszy wraz z ramką.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @return Liczba pól planszy powiększonej o ramkę.
+ */
+static inline uint64_t padded_size(gamma_t * g)
+{
+	return g->stride * ((uint64_t) g->height + 2);
+}
+
+/** @brief Podaje rozmiar tablic planszy w trybie gęstym. W układzie
+ * kafelkowym liczba wierszy zaokrąglana jest w górę do wielokrotności
+ * @ref TILE_SIDE.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @return Liczba elementów każdej z tablic planszy.
+ */
+static inline uint64_t storage_size(gamma_t * g)
+{
+	uint64_t rows = (uint64_t) g->height + 2;
+	if(g->stride_shift != 0)
+	{
+		rows = (rows + TILE_SIDE - 1) & ~(TILE_SIDE - 1);
+	}
+	return g->stride * rows;
+}
+
+/** @brief Ustawia rozmiary elementów tablic planszy: najmniejszy rozmiar
+ * elementu tablicy @p game_array, w którym mieszczą się numery wszystkich
+ * graczy oraz wartość pól ramki, i rozmiar elementu tablicy
+ * @p parent_array, w którym mieszczą się numery wszystkich pól.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ */
+static void set_element_sizes(gamma_t * g)
+{
+	if(g->players_count < UINT8_MAX)
+	{
+		g->cell_bytes = sizeof(uint8_t);
+	}
+	else if(g->players_count < UINT16_MAX)
+	{
+		g->cell_bytes = sizeof(uint16_t);
+	}
+	else if(g->players_count < UINT32_MAX)
+	{
+		g->cell_bytes = sizeof(uint32_t);
+	}
+	else
+	{
+		g->cell_bytes = sizeof(uint64_t);
+	}
+	uint64_t a_size = g->stride * ((uint64_t) g->height + 2);
+	g->parent_bytes = (a_size <= UINT32_MAX) ? sizeof(uint32_t)
+											 : sizeof(uint64_t);
+}
+
+/** @brief Sprawdza, czy w grze przechowywane są bitmapy pól graczy.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @return Wartość @p true, gdy plansza przechowywana jest w trybie gęstym,
+ * jej wymiary nie przekraczają @ref BITBOARD_MAX_SIDE, a liczba graczy
+ * @ref BITBOARD_MAX_PLAYERS, a @p false w przeciwnym wypadku.
+ */
+static inline bool has_bitboards(gamma_t * g)
+{
+	return (g->sparse_entries == NULL
+								&& g->width <= BITBOARD_MAX_SIDE
+								&& g->height <= BITBOARD_MAX_SIDE
+								&& g->players_count <= BITBOARD_MAX_PLAYERS);
+}
+
+/** @brief Rezerwuje w obszarze pamięci gry miejsce na tablicę,
+ * wyrównane do @ref ARENA_ALIGNMENT bajtów.
+ * @param[in,out] total 		  – rozmiar obszaru zajętego przez
+ *									poprzednie tablice
+ * @param[in] count 			  – liczba elementów tablicy
+ * @param[in] size 				  – rozmiar elementu tablicy w bajtach
+ * @param[out] offset 			  – położenie tablicy w obszarze
+ * @return Wartość @p false, gdy rozmiar obszaru nie mieści się
+ * w 64 bitach, a @p true w przeciwnym wypadku.
+ */
+static bool reserve_arena_block(uint64_t * total, uint64_t count,
+									uint64_t size, uint64_t * offset)
+{
+	uint64_t start = (*total + ARENA_ALIGNMENT - 1) & ~(uint64_t)
+														(ARENA_ALIGNMENT - 1);
+	if(start < *total || (count != 0 && size > (UINT64_MAX - start) / count))
+	{
+		return false;
+	}
+	*offset = start;
+	*total = start + count * size;
+	return true;
+}
+
+/** @brief Wyznacza położenie wszystkich tablic gry w jednym obszarze
+ * pamięci, zaczynającym się od adresu wyrównanego do
+ * @ref ARENA_ALIGNMENT bajtów. W trybie rzadkim tablice planszy są puste,
+ * a w trybie rzadkim graczy - tablice graczy. Stosy i tablica odwiedzin
+ * przeszukiwań obszarów nie należą do obszaru gry, zob. @ref scratch_header.
+ * @param[in] g 				  – wskaźnik na strukturę gry z ustawionymi
+ *									parametrami i rozmiarami elementów
+ * @param[out] offsets 			  – położenia kolejnych tablic, w kolejności
+ *									wartości @ref arena_block
+ * @param[out] total 			  – rozmiar obszaru w bajtach
+ * @return Wartość @p false, gdy rozmiar obszaru nie mieści się
+ * w 64 bitach, a @p true w przeciwnym wypadku.
+ */
+static bool arena_layout(gamma_t * g, uint64_t offsets[], uint64_t * total)
+{
+	uint64_t players = (g->player_table == NULL) ? g->players_count : 0;
+	uint64_t rows = has_bitboards(g) ? (players + 1) * g->height : 0;
+	uint64_t a_size = 0;
+	if(g->sparse_entries == NULL)
+	{
+		if(g->stride > UINT64_MAX / ((uint64_t) g->height + 2))
+		{
+			return false;
+		}
+		a_size = storage_size(g);
+	}
+	uint64_t board_rows = (a_size != 0) ? a_size / g->stride : 0;
+	uint64_t counts[ARENA_BLOCKS] = {a_size, a_size, a_size, players,
+								players, players, players, players, rows,
+								board_rows, board_rows};
+	uint64_t sizes[ARENA_BLOCKS] = {g->cell_bytes, g->parent_bytes,
+						sizeof(uint8_t), sizeof(uint32_t), sizeof(uint64_t),
+						sizeof(uint64_t), sizeof(bool), sizeof(uint64_t),
+						sizeof(uint64_t), sizeof(_Atomic uint64_t),
+						sizeof(uint64_t)};
+	*total = 0;
+	for(uint32_t i = 0; i < ARENA_BLOCKS; i++)
+	{
+		if(!reserve_arena_block(total, counts[i], sizes[i], &offsets[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** @brief Przydziela wyzerowany obszar pamięci gry. Na prośbę o duże
+ * strony odwzorowuje obszar wyrównany do @ref HUGE_PAGE_SIZE i zaleca
+ * systemowi umieszczenie go w dużych stronach; gdy odwzorowanie się nie
+ * powiedzie lub obszar jest mniejszy od dużej strony, przydziela pamięć
+ * funkcją @p calloc.
+ * @param[in] size 				  – rozmiar obszaru w bajtach
+ * @param[in] huge_pages 		  – czy obszar ma być umieszczony w dużych
+ *									stronach
+ * @param[out] mapped 			  – rozmiar odwzorowanego obszaru lub 0,
+ *									gdy został przydzielony funkcją
+ *									@p calloc
+ * @return Wskaźnik na obszar lub NULL, gdy nie udało się zaalokować
+ * pamięci.
+ */
+static unsigned char * allocate_arena(size_t size, bool huge_pages,
+														uint64_t * mapped)
+{
+	*mapped = 0;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	if(huge_pages && size >= HUGE_PAGE_SIZE
+		&& size <= SIZE_MAX - 2 * HUGE_PAGE_SIZE)
+	{
+		size_t length = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+		unsigned char * region = mmap(NULL, length + HUGE_PAGE_SIZE,
+						PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+						-1, 0);
+		if(region != MAP_FAILED)
+		{
+			size_t lead = (HUGE_PAGE_SIZE - (uintptr_t) region % HUGE_PAGE_SIZE)
+														% HUGE_PAGE_SIZE;
+			if(lead != 0)
+			{
+				munmap(region, lead);
+			}
+			munmap(region + lead + length, HUGE_PAGE_SIZE - lead);
+			madvise(region + lead, length, MADV_HUGEPAGE);
+			*mapped = length;
+			return region + lead;
+		}
+	}
+#else
+	(void) huge_pages;
+#endif
+	return calloc(1, size);
+}
+
+/** @brief Wyznacza rozmiar obszaru pamięci gry, mieszczącego strukturę
+ * gry i jej tablice.
+ * @param[in] params 			  – wskaźnik na strukturę gry z ustawionymi
+ *									parametrami i rozmiarami elementów
+ * @param[out] offsets 			  – położenia kolejnych tablic względem
+ *									pierwszego wyrównanego adresu za
+ *									strukturą gry
+ * @param[out] size 			  – rozmiar obszaru w bajtach
+ * @return Wartość @p false, gdy rozmiar obszaru nie mieści się
+ * w typie @p size_t, a @p true w przeciwnym wypadku.
+ */
+static bool game_size(const gamma_t * params, uint64_t offsets[],
+														uint64_t * size)
+{
+	uint64_t blocks_size;
+	if(!arena_layout((gamma_t *) params, offsets, &blocks_size)
+		|| blocks_size > SIZE_MAX - sizeof(gamma_t) - ARENA_ALIGNMENT)
+	{
+		return false;
+	}
+	*size = sizeof(gamma_t) + ARENA_ALIGNMENT + blocks_size;
+	return true;
+}
+
+/** @brief Podaje rozmiar obszaru pomocniczego gry, zob.
+ * @ref scratch_header.
+ * @param[in] g 				  – wskaźnik na strukturę gry w trybie gęstym
+ * @return Rozmiar obszaru w bajtach.
+ */
+static uint64_t scratch_size(gamma_t * g)
+{
+	uint64_t cells = (uint64_t) g->width * g->height;
+	return sizeof(scratch_header) + cells * sizeof(uint64_t)
+			+ padded_size(g) * sizeof(uint64_t) + cells * sizeof(dfs_frame);
+}
+
+/** @brief Umieszcza stosy i tablicę odwiedzin przeszukiwań obszarów gry
+ * w obszarze pomocniczym wywołującego.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ * @param[in] scratch 			  – obszar pomocniczy, nie mniejszy od
+ *									wartości @ref scratch_size
+ */
+static void attach_scratch(gamma_t * g, void * scratch)
+{
+	uint64_t cells = (uint64_t) g->width * g->height;
+	g->scratch = (scratch_header *) scratch;
+	g->scratch->owner = NULL;
+	g->area_stack = (uint64_t *) (g->scratch + 1);
+	g->area_stack_size = cells;
+	g->visits = g->area_stack + cells;
+	g->dfs_stack = (dfs_frame *) (g->visits + padded_size(g));
+	g->dfs_capacity = cells;
+}
+
+/** @brief Przydziela obszar pamięci gry i umieszcza w nim strukturę gry
+ * oraz jej tablice, wyzerowane. W trybie rzadkim graczy tablice graczy
+ * nie są umieszczane w obszarze. Gdy opcje wskazują obszar przydzielony
+ * przez wywołującego, gra umieszczana jest w nim, a stosy przeszukiwań
+ * obszarów - w obszarze pomocniczym z opcji, o ile go podano.
+ * @param[in] params 			  – wskaźnik na strukturę gry z ustawionymi
+ *									parametrami i rozmiarami elementów
+ * @param[in] options 			  – wskaźnik na opcje gry lub NULL
+ * @return Wskaźnik na strukturę gry lub NULL, gdy nie udało się
+ * zaalokować pamięci albo obszar wywołującego lub obszar pomocniczy jest
+ * za mały lub niewyrównany, lub gra w trybie rzadkim ma korzystać z obszaru
+ * pomocniczego.
+ */
+static gamma_t * allocate_game(const gamma_t * params,
+										const gamma_options_t * options)
+{
+	uint64_t offsets[ARENA_BLOCKS];
+	uint64_t size;
+	if(!game_size(params, offsets, &size))
+	{
+		return NULL;
+	}
+	if(options != NULL && options->scratch != NULL
+		&& (params->sparse_entries != NULL
+			|| options->scratch_size < scratch_size((gamma_t *) params)
+			|| (uintptr_t) options->scratch % _Alignof(max_align_t) != 0))
+	{
+		return NULL;
+	}
+	uint64_t mapped = 0;
+	unsigned char * arena = NULL;
+	bool borrowed = (options != NULL && options->storage != NULL);
+	if(borrowed)
+	{
+		if(options->storage_size < size
+			|| (uintptr_t) options->storage % _Alignof(max_align_t) != 0)
+		{
+			return NULL;
+		}
+		arena = memset(options->storage, 0, size);
+	}
+	else
+	{
+		arena = allocate_arena(size, options != NULL && options->huge_pages,
+																	&mapped);
+	}
+	if(arena == NULL)
+	{
+		return NULL;
+	}
+	gamma_t * new_gamma = (gamma_t *) arena;
+	*new_gamma = *params;
+	new_gamma->mapped_size = mapped;
+	new_gamma->borrowed = borrowed;
+	uintptr_t end = (uintptr_t) (arena + sizeof(gamma_t));
+	unsigned char * blocks = arena + sizeof(gamma_t)
+			+ ((ARENA_ALIGNMENT - end % ARENA_ALIGNMENT) % ARENA_ALIGNMENT);
+	new_gamma->game_array = blocks + offsets[ARENA_CELLS];
+	new_gamma->parent_array = blocks + offsets[ARENA_PARENTS];
+	new_gamma->rank_array = (uint8_t *) (blocks + offsets[ARENA_RANKS]);
+	if(new_gamma->sparse_entries == NULL)
+	{
+		new_gamma->row_sequences =
+				(_Atomic uint64_t *) (blocks + offsets[ARENA_ROW_SEQUENCES]);
+		new_gamma->open_rows = (uint64_t *) (blocks + offsets[ARENA_OPEN_ROWS]);
+	}
+	if(new_gamma->player_table != NULL)
+	{
+		return new_gamma;
+	}
+	new_gamma->areas_array = (uint32_t *) (blocks + offsets[ARENA_AREAS]);
+	new_gamma->occupied_fields_array =
+						(uint64_t *) (blocks + offsets[ARENA_OCCUPIED]);
+	new_gamma->free_neighbours = (uint64_t *) (blocks + offsets[ARENA_FREE]);
+	new_gamma->golden_used = (bool *) (blocks + offsets[ARENA_GOLDEN]);
+	new_gamma->golden_possible_cache =
+						(uint64_t *) (blocks + offsets[ARENA_CACHE]);
+	if(has_bitboards(new_gamma))
+	{
+		new_gamma->bitboards = (uint64_t *) (blocks + offsets[ARENA_BITBOARDS]);
+	}
+	if(options != NULL && options->scratch != NULL)
+	{
+		attach_scratch(new_gamma, options->scratch);
+	}
+	return new_gamma;
+}
+
+/** @brief Przydziela tablice graczy w trybie rzadkim graczy, z wyzerowanym
+ * elementem o indeksie 0, wspólnym dla graczy, którzy nie wykonali jeszcze
+ * ruchu. Nic nie robi w trybie gęstym graczy.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool allocate_players(gamma_t * g)
+{
+	if(g->player_table == NULL)
+	{
+		return true;
+	}
+	g->areas_array = NULL;
+	g->occupied_fields_array = NULL;
+	g->free_neighbours = NULL;
+	g->golden_used = NULL;
+	g->golden_possible_cache = NULL;
+	if(!resize_player_arrays(g, g->players_capacity))
+	{
+		return false;
+	}
+	(g->areas_array)[0] = 0;
+	(g->occupied_fields_array)[0] = 0;
+	(g->free_neighbours)[0] = 0;
+	(g->golden_used)[0] = false;
+	(g->golden_possible_cache)[0] = 0;
+	return true;
+}
+
+size_t gamma_storage_size(uint32_t width, uint32_t height, uint32_t players,
+															uint32_t areas)
+{
+	if(wrong_params(width, height, players, areas)
+		|| players >= SPARSE_MIN_PLAYERS)
+	{
+		return 0;
+	}
+	gamma_t params;
+	set_basic_gamma_params(&params, width, height, players, areas);
+	set_layout(&params);
+	set_element_sizes(&params);
+	uint64_t offsets[ARENA_BLOCKS];
+	uint64_t size;
+	if(params.stride > SPARSE_MIN_FIELDS / ((uint64_t) height + 2)
+		|| !game_size(&params, offsets, &size))
+	{
+		return 0;
+	}
+	return size;
+}
+
+size_t gamma_scratch_size(uint32_t width, uint32_t height)
+{
+	if(width == 0 || height == 0)
+	{
+		return 0;
+	}
+	gamma_t params;
+	set_basic_gamma_params(&params, width, height, 1, 1);
+	set_layout(&params);
+	if(params.stride > SPARSE_MIN_FIELDS / ((uint64_t) height + 2))
+	{
+		return 0;
+	}
+	return scratch_size(&params);
+}
+
+void gamma_delete(gamma_t * g)
+{
+	if(g != NULL)
+	{
+		if(g->scratch == NULL)
+		{
+			free(g->area_stack);
+			free(g->visits);
+			free(g->dfs_stack);
+		}
+		free(g->undo_log);
+		free(g->sparse_entries);
+		drop_adjacent_sets(g);
+		drop_area_sets(g);
+		drop_border_sets(g);
+		if(g->player_table != NULL)
+		{
+			free(g->areas_array);
+			free(g->occupied_fields_array);
+			free(g->free_neighbours);
+			free(g->golden_used);
+			free(g->golden_possible_cache);
+			free(g->player_table);
+		}
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		if(g->mapped_size != 0)
+		{
+			munmap(g, g->mapped_size);
+			return;
+		}
+#endif
+		if(!g->borrowed)
+		{
+			free(g);
+		}
+	}
+}
+
+/** @brief Zeruje w tablicach planszy wiersze, w których od utworzenia gry
+ * lub ostatniego wywołania funkcji @ref gamma_reset zajęto jakieś pole,
+ * w układzie kafelkowym zaokrąglone do pełnych wierszy kafelków, i ustawia
+ * na nowo pola ramki w tych wierszach. Wiersze tych samych numerów zajmują
+ * w obu układach ciągły fragment każdej z tablic planszy, więc zerowany
+ * fragment jest proporcjonalny do zajętej części planszy, a nie do jej
+ * rozmiaru. Nic nie robi w trybie rzadkim.
+ * @param[in,out] g 			  – wskaźnik na strukturę gry
+ * @param[in] offsets 			  – położenia tablic gry w obszarze pamięci
+ */
+static void clear_touched_rows(gamma_t * g, const uint64_t offsets[])
+{
+	if(g->sparse_entries != NULL || g->touched_low > g->touched_high)
+	{
+		return;
+	}
+	uint64_t rows = storage_size(g) / g->stride;
+	uint64_t first = g->touched_low / g->stride;
+	uint64_t last = (g->touched_high < storage_size(g))
+						? g->touched_high / g->stride + 1 : rows;
+	if(g->stride_shift != 0)
+	{
+		first &= ~(TILE_SIDE - 1);
+		last = (last + TILE_SIDE - 1) & ~(TILE_SIDE - 1);
+	}
+	unsigned char * blocks = (unsigned char *) g->game_array
+										- offsets[ARENA_CELLS];
+	uint8_t sizes[] = {g->cell_bytes, g->parent_bytes, sizeof(uint8_t)};
+	for(uint32_t i = ARENA_CELLS; i <= ARENA_RANKS; i++)
+	{
+		memset(blocks + offsets[i] + first * g->stride * sizes[i],
+				0, (last - first) * g->stride * sizes[i]);
+	}
+	set_frame_rows(g, first, last);
+	g->touched_low = UINT64_MAX;
+	g->touched_high = 0;
+}
+
+void gamma_reset(gamma_t * g)
+{
+	if(g == NULL)
+	{
+		return;
+	}
+	uint64_t offsets[ARENA_BLOCKS];
+	uint64_t blocks_size;
+	arena_layout(g, offsets, &blocks_size);
+	clear_touched_rows(g, offsets);
+	memset((unsigned char *) g->game_array - offsets[ARENA_CELLS]
+			+ offsets[ARENA_AREAS], 0,
+			offsets[ARENA_ROW_SEQUENCES] - offsets[ARENA_AREAS]);
+	if(g->sparse_entries != NULL)
+	{
+		memset(g->sparse_entries, 0, g->sparse_capacity * sizeof(sparse_entry));
+		g->sparse_size = 0;
+	}
+	if(g->player_table != NULL)
+	{
+		memset(g->player_table, 0, 2 * g->players_capacity * sizeof(player_slot));
+		g->players_active = 0;
+		(g->golden_possible_cache)[0] = 0;
+	}
+	g->busy_fields_count = 0;
+	g->hash = 0;
+	g->board_version++;
+	g->undo_size = 0;
+	g->stale_size = 0;
+	for(uint64_t i = 0; i < player_slots(g); i++)
+	{
+		if(g->adjacent_sets != NULL)
+		{
+			clear_field_set(&(g->adjacent_sets)[i]);
+		}
+		if(g->area_sets != NULL)
+		{
+			clear_field_set(&(g->area_sets)[i].roots);
+		}
+		if(g->border_sets != NULL)
+		{
+			clear_field_set(&(g->border_sets)[i]);
+		}
+	}
+}
+
+/** @brief Konwertuje wskazaną pozycję w postaci (x,y) do 
+ * liczby całkowitej, będącej indeksem, pod którym w tablicy
+ * game_array - polu w strukturze @p g znajduje się
+ * wskaźnik na pole przypisane tejże pozycji (x,y). Plansza jest
+ * otoczona ramką, więc sąsiedzi pola o numerze @p pos mają numery
+ * @p pos - 1, @p pos + 1, @p pos - @p stride oraz @p pos + @p stride.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] x 			 	  – numer kolumny
+ * @param[in] y 			 	  – numer wiersza
+ * @return Liczba całkowita - indeks, pod którym w tablicy
+ * przechowującej dane o polach na planszy znajduje się pole
+ * o podanych współrzędnych.
+ */
+static inline uint64_t convert_pos(gamma_t * g, uint32_t x, uint32_t y)
+{
+	uint64_t target_position = g->stride * ((uint64_t) y + 1) + (uint64_t) x + 1;
+	return target_position;
+}
+
+/** @struct topology
+ * Opis kształtu sąsiedztwa pól planszy. Sąsiedzi pola leżą w kwadracie
+ * 3 x 3 o środku w tym polu, więc ramka szerokości jednego pola otacza
+ * planszę niezależnie od kształtu sąsiedztwa. Opisy są stałymi, których
+ * adresy silniki gry (@ref DEFINE_ENGINE) przekazują wszystkim funkcjom
+ * zależnym od kształtu sąsiedztwa; po wstawieniu tych funkcji do silnika
+ * liczba sąsiadów i ich przesunięcia znane są w czasie kompilacji.
+ */
+typedef struct topology
+{
+	uint32_t neighbours;
+	/**< Liczba sąsiadów pola, nie większa od @ref NEIGHBOURS */
+	int8_t dx[NEIGHBOURS];
+	/**< Przesunięcia kolejnych sąsiadów pola wzdłuż wiersza; sąsiedzi
+	uporządkowani są cyklicznie */
+	int8_t dy[NEIGHBOURS];
+	/**< Przesunięcia kolejnych sąsiadów pola wzdłuż kolumny */
+	uint8_t ring;
+	/**< Maska pól otaczających pole (@ref ring_dx), które odczytuje funkcja
+	@ref local_areas_around: sąsiadów pola i pól łączących dwóch
+	niesąsiadujących ze sobą sąsiadów */
+	uint8_t ring_sides;
+	/**< Maska pól otaczających pole, które są jego sąsiadami */
+	uint8_t ring_links[RING_SIZE];
+	/**< Maski pól maski @p ring sąsiadujących z kolejnymi polami
+	otaczającymi pole */
+	uint8_t side_links[NEIGHBOURS];
+	/**< Maski sąsiadów pola sąsiadujących z kolejnymi jego sąsiadami */
+	uint8_t far_count[NEIGHBOURS];
+	/**< Liczba pól odległych o dwa kroki od pola, sąsiadujących z kolejnymi
+	jego sąsiadami */
+	uint8_t far[NEIGHBOURS][FAR_MAX];
+	/**< Numery tych pól w tablicach @p far_dx i @p far_dy */
+	int8_t far_dx[FAR_CELLS];
+	/**< Przesunięcia pól odległych o dwa kroki od pola wzdłuż wiersza */
+	int8_t far_dy[FAR_CELLS];
+	/**< Przesunięcia pól odległych o dwa kroki od pola wzdłuż kolumny */
+} topology;
+
+/** Przesunięcia pól otaczających pole wzdłuż wiersza, w kolejności
+ cyklicznej, zaczynając od pola (x, y - 1) */
+static const int8_t ring_dx[RING_SIZE] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+/** Przesunięcia pól otaczających pole wzdłuż kolumny */
+static const int8_t ring_dy[RING_SIZE] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+/** Plansza z pól kwadratowych, sąsiadujących bokami */
+static const topology square_topology =
+{
+	.neighbours = 4,
+	.dx = {0, 1, 0, -1},
+	.dy = {-1, 0, 1, 0},
+	.ring = 0xff,
+	.ring_sides = 0x55,
+	.ring_links = {0x82, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x41},
+	.side_links = {0x00, 0x00, 0x00, 0x00},
+	.far_count = {3, 3, 3, 3},
+	.far = {{0, 1, 2}, {1, 3, 4}, {4, 5, 6}, {2, 6, 7}},
+	.far_dx = {0, 1, -1, 2, 1, 0, -1, -2},
+	.far_dy = {-2, -1, -1, 0, 1, 2, 1, 0}
+};
+
+/** Plansza z pól sześciokątnych; kolejni sąsiedzi pola sąsiadują ze sobą */
+static const topology hex_topology =
+{
+	.neighbours = 6,
+	.dx = {0, 1, 1, 0, -1, -1},
+	.dy = {-1, -1, 0, 1, 1, 0},
+	.ring = 0x77,
+	.ring_sides = 0x77,
+	.ring_links = {0x42, 0x05, 0x12, 0x00, 0x24, 0x50, 0x21, 0x00},
+	.side_links = {0x22, 0x05, 0x0a, 0x14, 0x28, 0x11},
+	.far_count = {3, 3, 3, 3, 3, 3},
+	.far = {{0, 1, 2}, {1, 3, 4}, {4, 5, 6}, {6, 7, 8}, {8, 9, 10},
+			{2, 10, 11}},
+	.far_dx = {0, 1, -1, 2, 2, 2, 1, 0, -1, -2, -2, -2},
+	.far_dy = {-2, -2, -1, -2, -1, 0, 1, 2, 2, 2, 1, 0}
+};
+
+/** Plansza z pól kwadratowych, sąsiadujących bokami i narożnikami */
+static const topology square8_topology =
+{
+	.neighbours = 8,
+	.dx = {0, 1, 1, 1, 0, -1, -1, -1},
+	.dy = {-1, -1, 0, 1, 1, 1, 0, -1},
+	.ring = 0xff,
+	.ring_sides = 0xff,
+	.ring_links = {0xc6, 0x05, 0x1b, 0x14, 0x6c, 0x50, 0xb1, 0x41},
+	.side_links = {0xc6, 0x05, 0x1b, 0x14, 0x6c, 0x50, 0xb1, 0x41},
+	.far_count = {3, 5, 3, 5, 3, 5, 3, 5},
+	.far = {{0, 1, 2}, {1, 3, 4, 5, 0}, {4, 5, 6}, {5, 6, 7, 8, 9},
+			{8, 9, 10}, {9, 10, 11, 12, 13}, {12, 13, 14}, {2, 0, 13, 14, 15}},
+	.far_dx = {0, 1, -1, 2, 2, 2, 2, 2, 1, 0, -1, -2, -2, -2, -2, -2},
+	.far_dy = {-2, -2, -2, -2, -1, 0, 1, 2, 2, 2, 2, 2, 1, 0, -1, -2}
+};
+
+/** @brief Wyznacza numer pola przesuniętego względem danego pola.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] pos 			 	  – numer pola
+ * @param[in] dx 			 	  – przesunięcie wzdłuż wiersza
+ * @param[in] dy 			 	  – przesunięcie wzdłuż kolumny
+ * @return Numer pola, być może będącego polem ramki.
+ */
+static inline uint64_t shifted_pos(const gamma_t * g, uint64_t pos,
+														int64_t dx, int64_t dy)
+{
+	return pos + (uint64_t) (dy * (int64_t) g->stride + dx);
+}
+
+/** @brief Wyznacza numery sąsiadów pola w kolejności cyklicznej.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] t  			 	  – kształt sąsiedztwa pól
+ * @param[in] pos 			 	  – numer pola
+ * @param[out] around 		 	  – tablica numerów sąsiadów, być może
+ *									będących polami ramki; pierwszych
+ *									@p neighbours elementów to sąsiedzi,
+ *									a pozostałe są równe @p pos, więc
+ *									pętle po sąsiadach rozwinięte dla
+ *									największej ich liczby nie czytają
+ *									nieustalonych wartości
+ */
+TOPOLOGY_KERNEL void neighbours_of(const gamma_t * g, const topology * t,
+									uint64_t pos, uint64_t around[NEIGHBOURS])
+{
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < NEIGHBOURS; k++)
+	{
+		around[k] = (k < t->neighbours)
+					? shifted_pos(g, pos, t->dx[k], t->dy[k]) : pos;
+	}
+}
+
+/** @brief Sprawdza, czy podane współrzędne są zgodne z
+ * parametrami zapisanymi w strukturze gry.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] x 			 	  – numer kolumny
+ * @param[in] y 			 	  – numer wiersza
+ * @return Wartość @p true, jeśli podane współrzędne są poprawne dla
+ * gry zapisanej w strukturze, a @p false w przeciwnym wypadku.
+ */
+static inline bool check_coordinates(gamma_t * g, uint32_t x, uint32_t y)
+{
+	uint32_t bound_of_x = g->width;
+	uint32_t bound_of_y = g->height;
+	return(x < bound_of_x && y < bound_of_y);
+}
+
+/** @brief Podaje wskaźnik na pierwszy wiersz bitmapy gracza.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] player 	– numer gracza lub 0 dla bitmapy pól zajętych
+ * @return Wskaźnik na wiersz o numerze 0 bitmapy.
+ */
+static inline uint64_t * bitboard_rows(gamma_t * g, uint64_t player)
+{
+	return g->bitboards + player * g->height;
+}
+
+/** @brief Ustawia lub czyści bit pola o podanym numerze w bitmapie gracza.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] player 	– numer gracza lub 0 dla bitmapy pól zajętych
+ * @param[in] pos 		– numer pola
+ * @param[in] value 	– wartość @p true, gdy bit jest ustawiany,
+ *						  a @p false, gdy jest czyszczony
+ */
+static inline void bitboard_set(gamma_t * g, uint64_t player,
+											uint64_t pos, bool value)
+{
+	uint64_t * row = bitboard_rows(g, player) + (pos / g->stride - 1);
+	uint64_t bit = (uint64_t) 1 << (pos % g->stride - 1);
+	if(value)
+	{
+		STORE_SHARED(*row, *row | bit);
+	}
+	else
+	{
+		STORE_SHARED(*row, *row & ~bit);
+	}
+}
+
+/** @brief Wyznacza wiersz bitmapy pól sąsiadujących z polami bitmapy
+ * @p rows lub do niej należących. Wynik może zawierać bit leżący tuż
+ * za prawym brzegiem planszy.
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] rows 		– wiersze bitmapy
+ * @param[in] height 	– liczba wierszy bitmapy
+ * @param[in] y 		– numer wiersza
+ * @return Wiersz @p y poszerzonej bitmapy.
+ */
+TOPOLOGY_KERNEL uint64_t bitboard_dilate(const topology * t,
+							const uint64_t rows[], uint32_t height, uint32_t y)
+{
+	uint64_t result = rows[y];
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < t->neighbours; k++)
+	{
+		if((t->dy[k] < 0 && y == 0) || (t->dy[k] > 0 && y + 1 == height))
+		{
+			continue;
+		}
+		uint64_t row = rows[(int64_t) y + t->dy[k]];
+		result |= (t->dx[k] >= 0) ? (row >> t->dx[k]) : (row << -t->dx[k]);
+	}
+	return result;
+}
+
+/** @brief Rozszerza wiersz @p fill w obrębie wiersza @p area wzdłuż
+ * ciągłych fragmentów tego wiersza w obu kierunkach (wypełnienie
+ * Kogge-Stone'a, sześć kroków na kierunek).
+ * @param[in] fill 		– zbiór pól startowych, zawarty w @p area
+ * @param[in] area 		– zbiór pól, po których odbywa się wypełnienie
+ * @return Pola @p area osiągalne poziomo z pól @p fill.
+ */
+static inline uint64_t bitboard_fill_row(uint64_t fill, uint64_t area)
+{
+	uint64_t up = fill;
+	uint64_t down = fill;
+	uint64_t up_area = area;
+	uint64_t down_area = area;
+	for(uint32_t shift = 1; shift < 64; shift *= 2)
+	{
+		up |= up_area & (up << shift);
+		up_area &= up_area << shift;
+		down |= down_area & (down >> shift);
+		down_area &= down_area >> shift;
+	}
+	return up | down;
+}
+
+/** @brief Wyznacza pola bitmapy @p area osiągalne z pól @p fill.
+ * Pętle po wierszach nie zawierają zależności pomiędzy bitami, więc
+ * kompilator może je wektoryzować. Sąsiedzi pola w tym samym wierszu
+ * należą do otoczenia pola w każdym kształcie sąsiedztwa, więc wiersze
+ * wypełniane są funkcją @ref bitboard_fill_row.
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] area 		– wiersze bitmapy, po której odbywa się wypełnienie
+ * @param[in,out] fill 	– wiersze bitmapy pól startowych, zawartych
+ *						  w @p area; po wywołaniu pola osiągalne
+ * @param[in] height 	– liczba wierszy bitmap
+ */
+TOPOLOGY_KERNEL void bitboard_flood(const topology * t, const uint64_t area[],
+											uint64_t fill[], uint32_t height)
+{
+	bool changed = true;
+	while(changed)
+	{
+		changed = false;
+		for(uint32_t y = 0; y < height; y++)
+		{
+			uint64_t grown = bitboard_fill_row(
+						bitboard_dilate(t, fill, height, y) & area[y], area[y]);
+			changed |= (grown != fill[y]);
+			fill[y] = grown;
+		}
+		for(uint32_t y = height; y-- > 0; )
+		{
+			uint64_t grown = bitboard_fill_row(
+						bitboard_dilate(t, fill, height, y) & area[y], area[y]);
+			changed |= (grown != fill[y]);
+			fill[y] = grown;
+		}
+	}
+}
+
+/** @brief Podaje numer najmniej znaczącego ustawionego bitu.
+ * @param[in] bits 		– niezerowa liczba
+ * @return Numer najmniej znaczącego bitu równego 1.
+ */
+static inline uint32_t lowest_bit(uint64_t bits)
+{
+#if defined(__GNUC__)
+	return (uint32_t) __builtin_ctzll(bits);
+#else
+	uint32_t index = 0;
+	while((bits & 1) == 0)
+	{
+		bits >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+/** @brief Sprawdza, czy podany numer gracza jest w zakresie
+ * zgodnym z wartością ustawioną w strukturze gry.
+ * @p struktury @ref gamma_t.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] target_player  	  – numer gracza
+ * @return Wartość @p true, jeśli dany numer gracza jest poprawny,
+ * a @p false w przeciwnym wypadku.
+ */
+static inline bool is_player_in_range(gamma_t * g, uint64_t target_player)
+{
+	return (target_player > 0 && target_player <= g->players_count);
+}
+
+/** @brief Sprawdza, czy na polu znajduje się pionek wskazanego gracza.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer sprawdzanego pola, może
+ *								  wskazywać pole ramki
+ * @param[in] player 			– gracz, którego pionka
+ * 								  obecność na danym polu sprawdzamy
+ * @return Wartość @p true, gdy na wskazanym polu znajduje się pionek
+ * danego gracza, a @p false w przeciwnym wypadku.
+ */
+static inline bool is_on_field(gamma_t * g, uint64_t pos, uint32_t player)
+{
+	return (get_cell(g, pos) == player);
+}
+
+/** @brief Sprawdza, czy dany gracz może zająć nowy obszar, czyli
+ * czy liczba aktualnie zajętych przez niego obszarów jest
+ * mniejsza od dopuszczalnej liczby obszarów w posiadaniu
+ * jednego gracza.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] player        	  – numer gracza
+ * @return Wartość @p true, jeśli dany gracz może zająć nowy obszar,
+ * a wartość @p false w przeciwnym wypadku
+ */
+static inline bool can_have_more_areas(gamma_t * g, uint32_t player)
+{
+	if(g != NULL)
+	{
+        return (((g->areas_array)[player_index(g, player)])
+										< g->maximum_area_count);
+	}
+	else
+	{
+		return false;
+	}
+}
+
+/** @brief Sprawdza, czy pole o podanym numerze jest wolne
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] pos 				  – numer sprawdzanego pola
+ * @return Wartość @p true, jeśli na polu o podanym numerze nie znajduje się
+ * żaden pionek, a @p false jeśli pole to jest zajęte przez jakiegoś gracza
+ * lub należy do ramki.
+ */
+static inline bool is_field_free(gamma_t * g, uint64_t pos)
+{
+	return (get_cell(g, pos) == 0);
+}
+
+/** @brief Łączy pole o podanym numerze z sąsiadującymi polami
+ * należącymi do tego samego gracza, o ile wskazane pole jest przez niego
+ * zajęte - w przeciwnym wypadku połączenie pól nie następuje.
+ * @param[in] g              	  – wskaźnik na strukturę gry
+ * @param[in] t              	  – kształt sąsiedztwa pól
+ * @param[in] pos 			 	  – numer wskazanego pola
+ */
+TOPOLOGY_KERNEL void union_field(gamma_t * g, const topology * t, uint64_t pos)
+{
+	uint64_t current_player = get_cell(g, pos);
+	if(is_player_in_range(g, current_player))
+	{
+		uint64_t around[NEIGHBOURS];
+		neighbours_of(g, t, pos, around);
+		UNROLL_NEIGHBOURS
+		for(uint32_t k = 0; k < t->neighbours; k++)
+		{
+			if(get_cell(g, around[k]) == current_player)
+			{
+				connect_fields(g, pos, around[k]);
+			}
+		}
+	}
+}
+
+/** @brief Sprawdza na podstawie bitmapy gracza, czy pole o podanym numerze
+ * jest izolowane względem gracza o numerze @p player, zob.
+ * @ref is_field_isolated. Odczytuje co najwyżej trzy wiersze bitmapy
+ * zamiast pól planszy. Złoty ruch czasowo czyści pola obszaru gracza na
+ * planszy, nie zmieniając bitmap, więc w jego trakcie sprawdzane są pola.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry z bitmapami
+ * @param[in] t  			 	  – kształt sąsiedztwa pól
+ * @param[in] player  		 	  – numer gracza
+ * @param[in] pos 	  		 	  – numer pola, może wskazywać pole ramki
+ * @return Wartość @p true, gdy żaden sąsiad pola nie należy do gracza,
+ * a @p false w przeciwnym wypadku.
+ */
+TOPOLOGY_KERNEL bool bitboard_field_isolated(gamma_t * g, const topology * t,
+												uint32_t player, uint64_t pos)
+{
+	const uint64_t * own = bitboard_rows(g, player);
+	uint64_t y = pos / g->stride - 1;
+	uint64_t x = pos % g->stride - 1;
+	bool isolated = true;
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < t->neighbours; k++)
+	{
+		uint64_t near_y = y + (uint64_t) (int64_t) t->dy[k];
+		uint64_t near_x = x + (uint64_t) (int64_t) t->dx[k];
+		isolated = isolated && (near_y >= g->height || near_x >= g->width
+								|| ((own[near_y] >> near_x) & 1) == 0);
+	}
+	return isolated;
+}
+
+/** @brief Sprawdza, czy pole o podanym numerze jest izolowane
+ * względem gracza o numerze @p player. Przez pole izolowane względem gracza
+ * rozumiemy takie pole, że na żadnym z sąsiadujących z nim pól nie znajduje
+ * się pionek należący do wskazanego gracza.
+ * @param[in] g  			 	  – wskaźnik na strukturę gry
+ * @param[in] t  			 	  – kształt sąsiedztwa pól
+ * @param[in] player  		 	  – numer gracza
+ * @param[in] pos 	  		 	  – numer docelowego pola
+ */
+TOPOLOGY_KERNEL bool is_field_isolated(gamma_t * g, const topology * t,
+												uint32_t player, uint64_t pos)
+{
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	bool isolated = true;
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < t->neighbours; k++)
+	{
+		isolated = isolated && !is_on_field(g, around[k], player);
+	}
+	return isolated;
+}
+
+/** @brief Sprawdza, czy pole o podanym numerze nowym wolnym
+ * polem sąsiadującym z polem należącym do gracza @p player.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] t 				– kształt sąsiedztwa pól
+ * @param[in] player 			– numer gracza
+ * @param[in] pos 				– numer sprawdzanego pola
+ * @return Wartość @p true, jeśli dane pole jest nowe, a @p false jeśli
+ * pole to jest już uznane za wolne pole sąsiadujące z polem należącym
+ * do gracza @p player.
+ */
+TOPOLOGY_KERNEL bool is_new_free_neighbour(gamma_t * g, const topology * t,
+												uint32_t player, uint64_t pos)
+{
+	return (is_field_free(g, pos) && is_field_isolated(g, t, player, pos));
+}
+
+/** @brief Aktualizuje pomocniczą tablicę wyznaczającą liczbę różnych graczy
+ * sąsiadujących z polem, którego współrzędne przekazane zostały funkcji
+ * wywołującej @ref update_after_move.
+ * @param[in] array[] 			– aktualizowana tablica
+ * @param[in] *array_size 		– rozmiar tablicy
+ * @param[in] target_value		– liczba, którą chcemy umieścić w tablicy
+ */
+static void update_temp_neighbour_array(uint32_t array[], uint32_t * array_size, 
+									uint32_t target_value)
+{
+	bool different = true;
+	for(uint32_t i = 0; i < *array_size; i++)
+	{
+		if(array[i] == target_value)
+		{
+			different = false;
+		}
+	}
+	if(different)
+	{
+		array[*array_size] = target_value;
+		(*array_size)++;
+	}
+}
+					
+/** @brief Dodaje pole do zbioru wolnych pól przyległych do pól gracza
+ * lub usuwa je z tego zbioru, o ile zbiory te są utrzymywane. Gdy nie uda
+ * się zaalokować pamięci, zbiory przestają być utrzymywane.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola
+ * @param[in] add 			– wartość @p true, gdy pole dodajemy,
+ *							  a @p false, gdy je usuwamy
+ */
+static void update_adjacent_set(gamma_t * g, uint32_t player,
+											uint64_t pos, bool add)
+{
+	if(g->adjacent_sets == NULL)
+	{
+		return;
+	}
+	adjacent_set * set = &(g->adjacent_sets)[player_index(g, player)];
+	if(!add)
+	{
+		adjacent_set_remove(set, pos);
+	}
+	else if(!adjacent_set_add(set, pos))
+	{
+		drop_adjacent_sets(g);
+	}
+}
+
+/** @brief Aktualizuje liczbę wolnych pól przyległych do pól
+ * zajętych przez gracza @p player oraz zbiór tych pól.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola, które staje się lub przestaje
+ *							  być wolnym polem przyległym do pól gracza
+ * @param[in] increase		– wartość @p true, gdy zwiększamy,
+ *							  a @p false, gdy zmniejszamy
+ *							  (liczbę z opisu funkcji)
+ */
+static inline void update_neighbours_array(gamma_t * g, uint32_t player,
+											uint64_t pos, bool increase)
+{
+	uint64_t * free_count = &(g->free_neighbours)[player_index(g, player)];
+	if(increase)
+	{
+		STORE_SHARED(*free_count, *free_count + 1);
+	}
+	else
+	{
+		STORE_SHARED(*free_count, *free_count - 1);
+	}
+	update_adjacent_set(g, player, pos, increase);
+}
+
+/** @brief Tworzy zbiory wolnych pól przyległych do pól graczy na podstawie
+ * zawartości planszy, przeglądając ją jednokrotnie; w trybie rzadkim
+ * przeglądane są jedynie sąsiedztwa pól tablicy @p sparse_entries.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+TOPOLOGY_SHARED bool build_adjacent_sets(gamma_t * g, const topology * t)
+{
+	g->adjacent_sets = calloc(player_slots(g), sizeof(adjacent_set));
+	if(g->adjacent_sets == NULL)
+	{
+		return false;
+	}
+	for(uint64_t i = 0; g->sparse_entries != NULL && i < g->sparse_capacity; i++)
+	{
+		uint64_t pos = (g->sparse_entries)[i].pos;
+		uint64_t player = (g->sparse_entries)[i].player;
+		uint64_t around[NEIGHBOURS];
+		neighbours_of(g, t, pos, around);
+		for(uint32_t k = 0; pos != 0 && player != 0 && k < t->neighbours; k++)
+		{
+			if(get_cell(g, around[k]) == 0
+				&& !adjacent_set_add(&(g->adjacent_sets)[player_index(g, player)],
+																around[k]))
+			{
+				drop_adjacent_sets(g);
+				return false;
+			}
+		}
+	}
+	for(uint32_t j = 0; g->sparse_entries == NULL && j < g->height; j++)
+	{
+		for(uint32_t i = 0; i < g->width; i++)
+		{
+			uint64_t pos = convert_pos(g, i, j);
+			if(!is_field_free(g, pos))
+			{
+				continue;
+			}
+			uint64_t around[NEIGHBOURS];
+			neighbours_of(g, t, pos, around);
+			for(uint32_t k = 0; k < t->neighbours; k++)
+			{
+				uint64_t player = get_cell(g, around[k]);
+				if(is_player_in_range(g, player)
+					&& !adjacent_set_add(&(g->adjacent_sets)[player_index(g,
+																player)], pos))
+				{
+					drop_adjacent_sets(g);
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/** @brief Przywraca przynależność wolnych sąsiadów pola do zbiorów
+ * wolnych pól przyległych do pól graczy po zmianie zawartości tego pola
+ * przez cofnięcie ruchu.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] pos 			– numer pola
+ * @param[in] previous 		– zawartość pola przed cofnięciem ruchu
+ */
+TOPOLOGY_KERNEL void refresh_adjacent_sets(gamma_t * g, const topology * t,
+												uint64_t pos, uint64_t previous)
+{
+	uint64_t current = get_cell(g, pos);
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	for(uint32_t k = 0; k < t->neighbours && g->adjacent_sets != NULL; k++)
+	{
+		uint64_t player = get_cell(g, around[k]);
+		if(current == 0 && is_player_in_range(g, player))
+		{
+			update_adjacent_set(g, player, pos, true);
+		}
+		else if(player == 0)
+		{
+			if(is_player_in_range(g, previous))
+			{
+				update_adjacent_set(g, previous, around[k],
+								!is_field_isolated(g, t, previous, around[k]));
+			}
+			if(is_player_in_range(g, current))
+			{
+				update_adjacent_set(g, current, around[k], true);
+			}
+		}
+	}
+}
+
+/** @brief Dodaje pole do zbioru pól innych graczy przyległych do pól gracza
+ * lub usuwa je z tego zbioru, o ile zbiory te są utrzymywane. Gdy nie uda
+ * się zaalokować pamięci, zbiory przestają być utrzymywane.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola
+ * @param[in] add 			– wartość @p true, gdy pole dodajemy,
+ *							  a @p false, gdy je usuwamy
+ */
+static void update_border_set(gamma_t * g, uint32_t player,
+											uint64_t pos, bool add)
+{
+	if(g->border_sets == NULL)
+	{
+		return;
+	}
+	adjacent_set * set = &(g->border_sets)[player_index(g, player)];
+	if(!add)
+	{
+		adjacent_set_remove(set, pos);
+	}
+	else if(!adjacent_set_add(set, pos))
+	{
+		drop_border_sets(g);
+	}
+}
+
+/** @brief Ustala przynależność pola do zbioru pól innych graczy przyległych
+ * do pól gracza @p player na podstawie zawartości planszy.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola
+ */
+TOPOLOGY_KERNEL void refresh_border_field(gamma_t * g, const topology * t,
+												uint32_t player, uint64_t pos)
+{
+	uint64_t owner = get_cell(g, pos);
+	update_border_set(g, player, pos, is_player_in_range(g, owner)
+					&& owner != player && !is_field_isolated(g, t, player, pos));
+}
+
+/** @brief Przywraca przynależność pola i jego zajętych sąsiadów do zbiorów
+ * pól innych graczy przyległych do pól graczy po zmianie zawartości pola
+ * przez złoty ruch lub cofnięcie ruchu.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] pos 			– numer pola
+ * @param[in] previous 		– zawartość pola przed zmianą
+ */
+TOPOLOGY_KERNEL void refresh_border_sets(gamma_t * g, const topology * t,
+												uint64_t pos, uint64_t previous)
+{
+	uint64_t current = get_cell(g, pos);
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	if(is_player_in_range(g, previous))
+	{
+		refresh_border_field(g, t, previous, pos);
+	}
+	if(is_player_in_range(g, current))
+	{
+		refresh_border_field(g, t, current, pos);
+	}
+	for(uint32_t k = 0; k < t->neighbours && g->border_sets != NULL; k++)
+	{
+		uint64_t player = get_cell(g, around[k]);
+		if(!is_player_in_range(g, player))
+		{
+			continue;
+		}
+		refresh_border_field(g, t, player, pos);
+		if(is_player_in_range(g, previous))
+		{
+			refresh_border_field(g, t, previous, around[k]);
+		}
+		if(is_player_in_range(g, current))
+		{
+			refresh_border_field(g, t, current, around[k]);
+		}
+	}
+}
+
+/** @brief Tworzy zbiory pól innych graczy przyległych do pól graczy na
+ * podstawie zawartości planszy, przeglądając ją jednokrotnie; w trybie
+ * rzadkim przeglądane są jedynie pola tablicy @p sparse_entries.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+TOPOLOGY_SHARED bool build_border_sets(gamma_t * g, const topology * t)
+{
+	g->border_sets = calloc(player_slots(g), sizeof(adjacent_set));
+	if(g->border_sets == NULL)
+	{
+		return false;
+	}
+	uint64_t board_size = (g->sparse_entries != NULL) ? g->sparse_capacity
+														: padded_size(g);
+	for(uint64_t i = 0; i < board_size; i++)
+	{
+		uint64_t pos = (g->sparse_entries != NULL)
+								? (g->sparse_entries)[i].pos : i;
+		uint64_t owner = (pos != 0) ? get_cell(g, pos) : 0;
+		if(!is_player_in_range(g, owner))
+		{
+			continue;
+		}
+		uint64_t around[NEIGHBOURS];
+		neighbours_of(g, t, pos, around);
+		for(uint32_t k = 0; k < t->neighbours; k++)
+		{
+			uint64_t player = get_cell(g, around[k]);
+			if(is_player_in_range(g, player) && player != owner
+				&& !adjacent_set_add(&(g->border_sets)[player_index(g, player)],
+																		pos))
+			{
+				drop_border_sets(g);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/** @brief Uaktualnia liczbę wolnych sąsiednich pól gracza po wykonaniu
+ * złotego ruchu na pole o danym numerze.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– numer gracza, dla którego aktualizujemy
+ * 						  liczbę wolnych sąsiednich pól
+ * @param[in] pos 		– numer danego pola
+ * @param[in] increase 	– czy zwiększamy liczbę wolnych sąsiednich pól,
+ * 						  wartość @p true jeśli tak, a @p false w 
+ * 						  przeciwnym wypadku
+ */
+TOPOLOGY_KERNEL void update_neighbours(gamma_t * g, const topology * t,
+								uint32_t player, uint64_t pos, bool increase)
+{
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < t->neighbours; k++)
+	{
+		if(is_new_free_neighbour(g, t, player, around[k]))
+		{
+			update_neighbours_array(g, player, around[k], increase);
+		}
+	}
+}
+
+/** @brief Wypełnia tablicę pomocniczą. Funkcja pomocnicza, wywoływana przez
+ * funkcję @ref player_areas_around.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] t 				– kształt sąsiedztwa pól
+ * @param[in] player 			– numer gracza, scharakteryzowany w opisie funkcji
+ * 								  @ref player_areas_around
+ * @param[in] pos 				– numer pola opisanego w opisie funkcji
+ * 								  @ref player_areas_around
+ * @param[in] array[] 			– wypełniana tablica
+ * @param[in] *array_size 		– wskaźnik na rozmiar wypełnianej tablicy
+ */
+TOPOLOGY_KERNEL void set_temp_fields_array(gamma_t * g, const topology * t,
+		uint32_t player, uint64_t pos, uint64_t array[], uint32_t * array_size)
+{
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < t->neighbours; k++)
+	{
+		if(is_on_field(g, around[k], player))
+		{
+			array[*array_size] = around[k];
+			(*array_size)++;
+		}
+	}
+}
+
+/** @brief Zlicza ile różnych elementów znajduje się w tablicy
+ * @p array. Funkcja pomocnicza, wywoływana przez funkcję
+ * liczącą @ref player_areas_around
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] array[] 		– wskaźnik na pierwszy element tablicy
+ * @param[in] array_size 	– rozmiar tablicy
+ * @return Liczba różnych elementów w tablicy array
+ */
+static uint32_t count_areas(gamma_t * g, uint64_t array[], uint32_t array_size)
+{
+	uint32_t count_of_areas = 0;
+	for(uint32_t i = 0; i < array_size; i++)
+	{
+		bool different = true;
+		for(uint32_t j = 0; j < i && different; j++)
+		{
+			if(find_field(g, array[i]) == find_field(g, array[j]))
+			{
+				different = false;
+			}
+		}
+		if(different)
+		{
+			count_of_areas++;
+		}
+	}	
+	return count_of_areas;
+}
+
+/** @brief Liczy z iloma różnymi polami należącymi do gracza o numerze
+ * @p player_id sąsiaduje pole o podanym numerze.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player_id 	– numer gracza, którego ewentualne obszary 
+ *							  przyległe do wskazanego pola chcemy sprawdzić
+ * @param[in] pos 			– numer wskazanego pola
+ * @return Liczba różnych obszarów należących do gracza @p player_id, do
+ * których przyległe jest pole o numerze @p pos
+ */
+TOPOLOGY_KERNEL uint32_t player_areas_around(gamma_t * g, const topology * t,
+											uint32_t player_id, uint64_t pos)
+{
+	uint64_t temp_array[NEIGHBOURS];
+	uint32_t array_size = 0;
+	set_temp_fields_array(g, t, player_id, pos, temp_array, &array_size);
+	uint32_t p_areas_around = count_areas(g, temp_array, array_size);
+	return p_areas_around;
+}
+
+/** @struct neighbourhood
+ * Otoczenie pola, na które wykonywany jest zwykły ruch, odczytane
+ * z planszy jednokrotnie. Sąsiedzi są uporządkowani cyklicznie, jak
+ * w funkcji @ref neighbours_of.
+ */
+typedef struct neighbourhood
+{
+	uint64_t pos[NEIGHBOURS];
+	/**< Numery sąsiadów pola */
+	uint64_t owner[NEIGHBOURS];
+	/**< Zawartość sąsiadów pola: 0 dla pól wolnych, numer gracza
+	lub wartość pola ramki */
+} neighbourhood;
+
+/** @brief Odczytuje zawartość sąsiadów pola o podanym numerze.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] pos 			– numer pola
+ * @param[out] n 			– wypełniane otoczenie pola
+ */
+TOPOLOGY_KERNEL void gather_neighbourhood(gamma_t * g, const topology * t,
+												uint64_t pos, neighbourhood * n)
+{
+	neighbours_of(g, t, pos, n->pos);
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		n->owner[i] = get_cell(g, n->pos[i]);
+	}
+}
+
+/** @brief Sprawdza, czy w otoczeniu pola nie ma pionka gracza @p player.
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] n 			– otoczenie pola
+ * @param[in] player 		– numer gracza
+ * @return Wartość @p true, gdy pole jest izolowane względem gracza,
+ * a @p false w przeciwnym wypadku.
+ */
+TOPOLOGY_KERNEL bool is_isolated_in(const topology * t, const neighbourhood * n,
+																uint32_t player)
+{
+	bool isolated = true;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		isolated = isolated && (n->owner[i] != player);
+	}
+	return isolated;
+}
+
+/** @brief Liczy, na podstawie bitmapy gracza, wolnych sąsiadów pola
+ * o podanym numerze, które po zajęciu go przez gracza @p player staną się
+ * nowymi wolnymi polami przyległymi do jego pól, zob.
+ * @ref count_new_free_neighbours. Zamiast pól odległych o dwa kroki
+ * odczytywanych jest pięć wierszy bitmapy; samo pole @p pos jest w nich
+ * pomijane, bo może należeć do gracza, gdy wyznaczane są skutki złotego
+ * ruchu.
+ * @param[in] g 			– wskaźnik na strukturę gry z bitmapami
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola
+ * @param[in] n 			– otoczenie pola
+ * @param[out] added 		– tablica, do której trafiają numery nowych
+ *							  wolnych pól przyległych, lub NULL
+ * @return Liczba nowych wolnych pól przyległych do pól gracza.
+ */
+TOPOLOGY_KERNEL uint32_t bitboard_new_free_neighbours(gamma_t * g,
+	const topology * t, uint32_t player, uint64_t pos, const neighbourhood * n,
+															uint64_t added[])
+{
+	const uint64_t * own = bitboard_rows(g, player);
+	uint64_t y = pos / g->stride - 1;
+	uint64_t x = pos % g->stride - 1;
+	uint64_t window[5];
+	for(uint32_t r = 0; r < 5; r++)
+	{
+		uint64_t row = y + r - 2;
+		window[r] = (row < g->height) ? LOAD_SHARED(own[row]) : 0;
+	}
+	window[2] &= ~((uint64_t) 1 << x);
+	uint64_t near[3];
+	for(uint32_t r = 0; r < 3; r++)
+	{
+		near[r] = bitboard_dilate(t, window, 5, r + 1);
+	}
+	uint32_t count = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		uint64_t near_x = x + (uint64_t) (int64_t) t->dx[i];
+		if(n->owner[i] == 0 && ((near[t->dy[i] + 1] >> near_x) & 1) == 0)
+		{
+			if(added != NULL)
+			{
+				added[count] = n->pos[i];
+			}
+			count++;
+		}
+	}
+	return count;
+}
+
+/** @brief Liczy wolnych sąsiadów pola o podanym numerze, które po zajęciu
+ * go przez gracza @p player staną się nowymi wolnymi polami przyległymi
+ * do jego pól. Sąsiedzi wolnego sąsiada, którzy sąsiadują także z polem,
+ * znajdują się w otoczeniu @p n; pozostałe pola odległe o dwa kroki od pola
+ * odczytywane są z planszy co najwyżej raz, dopiero gdy są potrzebne.
+ * Na planszach z bitmapami pola te liczy
+ * @ref bitboard_new_free_neighbours.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola
+ * @param[in] n 			– otoczenie pola
+ * @param[out] added 		– tablica, do której trafiają numery nowych
+ *							  wolnych pól przyległych, lub NULL
+ * @return Liczba nowych wolnych pól przyległych do pól gracza.
+ */
+TOPOLOGY_KERNEL uint32_t count_new_free_neighbours(gamma_t * g,
+	const topology * t, uint32_t player, uint64_t pos, const neighbourhood * n,
+															uint64_t added[])
+{
+	if(g->bitboards != NULL)
+	{
+		return bitboard_new_free_neighbours(g, t, player, pos, n, added);
+	}
+	uint32_t own = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		own |= (uint32_t) (n->owner[i] == player) << i;
+	}
+	uint32_t read = 0;
+	uint32_t taken = 0;
+	uint32_t count = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		if(n->owner[i] != 0 || (own & t->side_links[i]) != 0)
+		{
+			continue;
+		}
+		bool far_taken = false;
+		for(uint32_t j = 0; j < t->far_count[i] && !far_taken; j++)
+		{
+			uint32_t far = t->far[i][j];
+			if((read & ((uint32_t) 1 << far)) == 0)
+			{
+				uint64_t far_pos = shifted_pos(g, pos, t->far_dx[far],
+														t->far_dy[far]);
+				read |= (uint32_t) 1 << far;
+				taken |= (uint32_t) is_on_field(g, far_pos, player) << far;
+			}
+			far_taken = ((taken & ((uint32_t) 1 << far)) != 0);
+		}
+		if(!far_taken)
+		{
+			if(added != NULL)
+			{
+				added[count] = n->pos[i];
+			}
+			count++;
+		}
+	}
+	return count;
+}
+
+/** @brief Aktualizuje parametry gracza oraz pola po wykonaniu zwykłego ruchu.
+ * Wszystkie zmiany wyznaczane są na podstawie jednokrotnie odczytanego
+ * otoczenia pola.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] executor      – numer gracza wykonującego ruch
+ * @param[in] current 		– numer pola, które zajął w ruchu gracz
+ *							  @p executor
+ * @param[in] n 			– otoczenie pola @p current
+ */
+TOPOLOGY_KERNEL void update_after_move(gamma_t * g, const topology * t,
+				uint32_t executor, uint64_t current, const neighbourhood * n)
+{
+	log_move(g);
+	log_change(g, UNDO_CELL, current, 0);
+	log_change(g, UNDO_BUSY, 0, g->busy_fields_count);
+	log_player(g, executor);
+	uint64_t added[NEIGHBOURS];
+	uint32_t added_size = count_new_free_neighbours(g, t, executor, current,
+																n, added);
+	uint64_t index = player_index(g, executor);
+	STORE_SHARED((g->free_neighbours)[index],
+					(g->free_neighbours)[index] + added_size);
+	uint32_t touching[NEIGHBOURS];
+	uint32_t touching_size = 0;
+	uint64_t roots[NEIGHBOURS];
+	uint32_t roots_size = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		if(is_player_in_range(g, n->owner[i]))
+		{
+			update_temp_neighbour_array(touching, &touching_size, n->owner[i]);
+		}
+		if(n->owner[i] == executor)
+		{
+			uint64_t root = find_field(g, n->pos[i]);
+			bool different = true;
+			for(uint32_t j = 0; j < roots_size && different; j++)
+			{
+				different = (roots[j] != root);
+			}
+			if(different)
+			{
+				roots[roots_size++] = root;
+			}
+		}
+	}
+	for(uint32_t i = 0; i < touching_size; i++)
+	{
+		log_change(g, UNDO_FREE, touching[i] - 1,
+					(g->free_neighbours)[player_index(g, touching[i])]);
+		update_neighbours_array(g, touching[i], current, false);
+	}
+	for(uint32_t i = 0; i < added_size && g->adjacent_sets != NULL; i++)
+	{
+		update_adjacent_set(g, executor, added[i], true);
+	}
+	for(uint32_t i = 0; i < t->neighbours && g->border_sets != NULL; i++)
+	{
+		if(is_player_in_range(g, n->owner[i]) && n->owner[i] != executor)
+		{
+			update_border_set(g, n->owner[i], current, true);
+			update_border_set(g, executor, n->pos[i], true);
+		}
+	}
+	set_cell(g, current, executor);
+	g->hash ^= zobrist_cell(current, executor);
+	if(current < g->touched_low)
+	{
+		g->touched_low = current;
+	}
+	if(current > g->touched_high)
+	{
+		g->touched_high = current;
+	}
+	if(g->bitboards != NULL)
+	{
+		bitboard_set(g, 0, current, true);
+		bitboard_set(g, executor, current, true);
+	}
+
+	STORE_SHARED(g->busy_fields_count, g->busy_fields_count + 1);
+
+	STORE_SHARED((g->occupied_fields_array)[index],
+					(g->occupied_fields_array)[index] + 1);
+	STORE_SHARED((g->areas_array)[index],
+					(g->areas_array)[index] + 1 - roots_size);
+
+	uint64_t root = current;
+	for(uint32_t i = 0; i < roots_size; i++)
+	{
+		root = link_roots(g, root, roots[i]);
+	}
+	join_areas(g, executor, current, roots, roots_size, root);
+	g->board_version++;
+}
+
+uint64_t gamma_busy_fields(gamma_t * g, uint32_t player)
+{
+	if(g != NULL && is_player_in_range(g, player))
+	{
+		return LOAD_SHARED((g->occupied_fields_array)[player_index(g, player)]);
+	}
+	else
+	{
+		return 0;
+	}
+}
+                                                                           
+uint64_t gamma_free_fields(gamma_t * g, uint32_t player)
+{
+	if(g != NULL && is_player_in_range(g, player))
+	{
+		uint64_t b_size = (uint64_t) g->width * (uint64_t) g->height;
+		uint64_t index = player_index(g, player);
+		uint64_t sequence;
+		uint64_t free_count;
+		do
+		{
+			sequence = read_begin(&g->sequence);
+			if(LOAD_SHARED((g->areas_array)[index]) < g->maximum_area_count)
+			{
+				free_count = b_size - LOAD_SHARED(g->busy_fields_count);
+			}
+			else
+			{
+				free_count = LOAD_SHARED((g->free_neighbours)[index]);
+			}
+		} while(read_retry(&g->sequence, sequence));
+		return free_count;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+/** @brief Aktualizuje powiązania między polami należącymi do
+ * tego samego spójnego obszaru na planszy.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ */
+TOPOLOGY_SHARED void update_board_golden(gamma_t * g, const topology * t)
+{
+	if(g != NULL && g->sparse_entries != NULL)
+	{
+		for(uint64_t i = 0; i < g->sparse_capacity; i++)
+		{
+			uint64_t pos = (g->sparse_entries)[i].pos;
+			if(pos != 0)
+			{
+				change_parent(g, pos, pos);
+				change_rank(g, pos, 0);
+			}
+		}
+		for(uint64_t i = 0; i < g->sparse_capacity; i++)
+		{
+			if((g->sparse_entries)[i].pos != 0)
+			{
+				union_field(g, t, (g->sparse_entries)[i].pos);
+			}
+		}
+	}
+	else if(g != NULL)
+	{
+		uint64_t board_size = padded_size(g);
+		for(uint64_t i = 0; i < board_size; i++)
+		{
+			change_parent(g, i, i);
+			change_rank(g, i, 0);
+		}
+		for(uint64_t i = 0; i < board_size; i++)
+		{
+			union_field(g, t, i);
+		}
+	}
+	if(g != NULL)
+	{
+		g->stale_size = 0;
+		drop_area_sets(g);
+	}
+}
+
+/** @brief Aktualizuje parametry gracza po złotym ruchu.
+ * Wywoływana na rzecz zarówno gracza wykonującego ten ruch, jak i
+ * gracza, którego pionek zostaje zabrany z planszy gry.
+ * @param[in] g 				– 	wskaźnik na strukturę gry
+ * @param[in] t 				– kształt sąsiedztwa pól
+ * @param[in] player 			– 	numer gracza, którego parametry aktualizujemy
+ * @param[in] pos 				– 	numer pola, na które wykonany został
+ *									złoty ruch
+ * @param[in] is_move_executor 	– 	czy aktualizujemy parametry gracza
+ * 									wykonującego złoty ruch, wartość @p true, 
+ *									gdy aktualizacja parametrów dotyczy gracza 
+ *									wykonującego ruch, a @p false, gdy
+ * 									aktualizujemy parametry gracza, którego
+ *								 	pionek został zabrany z planszy.
+ * @param[in] areas 			– 	liczba obszarów gracza przyległych
+ *									do pola @p pos, z pominięciem tego pola
+ */
+TOPOLOGY_KERNEL void update_player_golden(gamma_t * g, const topology * t,
+		uint32_t player, uint64_t pos, bool is_move_executor, uint32_t areas)
+{
+	uint64_t index = player_index(g, player);
+	if(is_move_executor)
+	{
+		STORE_SHARED((g->areas_array)[index],
+						(g->areas_array)[index] + 1 - areas);
+		STORE_SHARED((g->occupied_fields_array)[index],
+						(g->occupied_fields_array)[index] + 1);
+		(g->golden_used)[index] = true;
+		update_neighbours(g, t, player, pos, true);
+	}
+	else
+	{
+		STORE_SHARED((g->areas_array)[index],
+						(g->areas_array)[index] + areas - 1);
+		STORE_SHARED((g->occupied_fields_array)[index],
+						(g->occupied_fields_array)[index] - 1);
+		update_neighbours(g, t, player, pos, false);
+	}
+}
+
+/** @brief Sprawdza, czy w wyniku wykonania złotego ruchu
+ * ani gracz wykonujący ten ruch, ani gracz, którego pionek jest
+ * zdejmowany z planszy, nie wejdzie w posiadanie zbyt dużej liczby
+ * obszarów przekraczającej tę dopuszczalną ustaloną w strukturze
+ * @p g gry.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] executor  – numer gracza wykonującego złoty ruch
+ * @param[in] victim 	– numer gracza, którego pole zostaje zajęte
+ * 						  przez gracza wykonującego złoty ruch
+ * @param[in] vic_around – liczba obszarów gracza @p victim przyległych
+ *						  do pola po zdjęciu z niego pionka
+ * @param[in] pos 		– numer pola, na które wykonywany jest złoty ruch
+ * @return Wartość @p true, gdy ruch jest legalny i żaden z graczy
+ * nie będzie posiadał zbyt wielu obszarów, a @p false, gdy ruch
+ * nie jest legalny, bo któryś z graczy przekroczy dozwoloną
+ * liczbę obszarów
+ */
+TOPOLOGY_KERNEL bool area_check_golden(gamma_t * g, const topology * t,
+		uint32_t executor, uint32_t victim, uint32_t vic_around, uint64_t pos)
+{
+	uint32_t area_limit = g->maximum_area_count;
+
+	uint32_t exec_around = player_areas_around(g, t, executor, pos);
+
+	uint32_t exec_areas = (g->areas_array)[player_index(g, executor)]
+												+ 1 - exec_around;
+	uint32_t vic_areas = (g->areas_array)[player_index(g, victim)]
+												+ vic_around - 1;
+
+	return (exec_areas <= area_limit && vic_areas <= area_limit);
+}
+
+/** @brief Przejmuje obszar pomocniczy wywołującego, jeśli ostatnio
+ * korzystała z niego inna gra: zeruje tablicę @p visits, w której mogą
+ * leżeć stosy lub wpisy tamtej gry. Nic nie robi w grze bez obszaru
+ * pomocniczego.
+ * @param[in,out] g 	– wskaźnik na strukturę gry
+ */
+static inline void claim_scratch(gamma_t * g)
+{
+	if(g->scratch != NULL && g->scratch->owner != g)
+	{
+		memset(g->visits, 0, padded_size(g) * sizeof(uint64_t));
+		g->scratch->owner = g;
+	}
+}
+
+/** @brief Odkłada pole na stos pomocniczy @p area_stack, powiększając
+ * go w razie potrzeby. Stos w obszarze pomocniczym wywołującego
+ * nie jest powiększany.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] top 		– wskaźnik na liczbę pól znajdujących się na stosie
+ * @param[in] pos 		– numer odkładanego pola
+ * @return Wartość @p true, gdy pole zostało odłożone na stos, a @p false,
+ * gdy nie udało się zaalokować pamięci.
+ */
+static bool push_area_stack(gamma_t * g, uint64_t * top, uint64_t pos)
+{
+	claim_scratch(g);
+	if(*top == g->area_stack_size && g->scratch != NULL)
+	{
+		return false;
+	}
+	if(*top == g->area_stack_size)
+	{
+		uint64_t new_size = 2 * g->area_stack_size + 16;
+		uint64_t * new_stack = realloc(g->area_stack, new_size * sizeof(uint64_t));
+		if(new_stack == NULL)
+		{
+			return false;
+		}
+		g->area_stack = new_stack;
+		g->area_stack_size = new_size;
+	}
+	(g->area_stack)[*top] = pos;
+	(*top)++;
+	return true;
+}
+
+/** @brief Odkłada na stos pole o podanym numerze, o ile należy
+ * ono do gracza @p victim i nie zostało jeszcze odwiedzone. Odwiedzone
+ * pole jest tymczasowo oznaczane na planszy jako wolne.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] victim 	– numer gracza, którego obszar przeszukujemy
+ * @param[in] pos 		– numer pola
+ * @param[in] top 		– wskaźnik na liczbę pól znajdujących się na stosie
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool visit_area_field(gamma_t * g, uint32_t victim,
+								uint64_t pos, uint64_t * top)
+{
+	if(is_on_field(g, pos, victim))
+	{
+		if(!push_area_stack(g, top, pos))
+		{
+			return false;
+		}
+		set_cell(g, pos, 0);
+	}
+	return true;
+}
+
+/** @brief Odwiedza nieodwiedzone pola gracza @p victim sąsiadujące
+ * z polem o podanym numerze.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza, którego obszar przeszukujemy
+ * @param[in] pos 		– numer pola
+ * @param[in] top 		– wskaźnik na liczbę pól znajdujących się na stosie
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+TOPOLOGY_KERNEL bool visit_area_neighbours(gamma_t * g, const topology * t,
+								uint32_t victim, uint64_t pos, uint64_t * top)
+{
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	bool visited = true;
+	for(uint32_t k = 0; k < t->neighbours && visited; k++)
+	{
+		visited = visit_area_field(g, victim, around[k], top);
+	}
+	return visited;
+}
+
+/** @brief Przywraca pionki gracza @p victim na pola odłożone na stos
+ * przez funkcję @ref split_victim_area.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] victim 	– numer gracza
+ * @param[in] top 		– liczba pól znajdujących się na stosie
+ */
+static void restore_victim_area(gamma_t * g, uint32_t victim, uint64_t top)
+{
+	for(uint64_t i = 0; i < top; i++)
+	{
+		set_cell(g, (g->area_stack)[i], victim);
+	}
+}
+
+/** @brief Wyznacza obszary gracza @p victim przyległe do pola @p pos
+ * wypełnieniem bitmapy jego pól, z której usunięto to pole. Pola kolejnych
+ * obszarów trafiają na stos @p area_stack, o ile @p top nie ma wartości
+ * NULL. Plansza nie jest modyfikowana.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza, którego pionek został zdjęty
+ * @param[in] pos 		– numer pola
+ * @param[out] starts 	– tablica indeksów stosu, od których zaczynają
+ *						  się kolejne obszary, lub NULL
+ * @param[out] top 		– wskaźnik na liczbę pól odłożonych na stos lub NULL,
+ *						  gdy wyznaczana jest jedynie liczba obszarów
+ * @return Liczba obszarów przyległych do pola lub @p UINT32_MAX, gdy
+ * nie udało się zaalokować pamięci.
+ */
+TOPOLOGY_KERNEL uint32_t bitboard_split_victim_area(gamma_t * g,
+		const topology * t, uint32_t victim, uint64_t pos, uint64_t starts[],
+																uint64_t * top)
+{
+	uint64_t area[BITBOARD_MAX_SIDE];
+	uint64_t fill[BITBOARD_MAX_SIDE];
+	uint64_t * rows = bitboard_rows(g, victim);
+	for(uint32_t y = 0; y < g->height; y++)
+	{
+		area[y] = rows[y];
+	}
+	area[pos / g->stride - 1] &= ~((uint64_t) 1 << (pos % g->stride - 1));
+	uint64_t neighbours[NEIGHBOURS];
+	uint32_t neighbours_size = 0;
+	set_temp_fields_array(g, t, victim, pos, neighbours, &neighbours_size);
+	uint32_t areas = 0;
+	if(top != NULL)
+	{
+		*top = 0;
+	}
+	for(uint32_t i = 0; i < neighbours_size; i++)
+	{
+		uint64_t y = neighbours[i] / g->stride - 1;
+		uint64_t bit = (uint64_t) 1 << (neighbours[i] % g->stride - 1);
+		if((area[y] & bit) == 0)
+		{
+			continue;
+		}
+		for(uint32_t j = 0; j < g->height; j++)
+		{
+			fill[j] = 0;
+		}
+		fill[y] = bit;
+		bitboard_flood(t, area, fill, g->height);
+		if(top != NULL)
+		{
+			starts[areas] = *top;
+		}
+		areas++;
+		for(uint32_t j = 0; j < g->height; j++)
+		{
+			area[j] &= ~fill[j];
+			for(uint64_t bits = fill[j]; bits != 0 && top != NULL; bits &= bits - 1)
+			{
+				if(!push_area_stack(g, top, convert_pos(g, lowest_bit(bits), j)))
+				{
+					return UINT32_MAX;
+				}
+			}
+		}
+	}
+	return areas;
+}
+
+/** @brief Wyznacza obszary gracza @p victim przyległe do pola @p pos,
+ * z którego zdjęto już pionek tego gracza. Przeszukiwany jest wyłącznie
+ * dawny obszar zawierający to pole. Pola kolejnych obszarów trafiają na
+ * stos @p area_stack, a na planszy są tymczasowo oznaczone jako wolne.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza, którego pionek został zdjęty
+ * @param[in] pos 		– numer pola
+ * @param[out] starts 	– tablica indeksów stosu, od których zaczynają
+ *						  się kolejne obszary
+ * @param[out] top 		– wskaźnik na liczbę pól odłożonych na stos
+ * @return Liczba obszarów przyległych do pola lub @p UINT32_MAX, gdy
+ * nie udało się zaalokować pamięci (wówczas plansza pozostaje niezmieniona).
+ */
+TOPOLOGY_KERNEL uint32_t split_victim_area(gamma_t * g, const topology * t,
+			uint32_t victim, uint64_t pos, uint64_t starts[], uint64_t * top)
+{
+	if(g->bitboards != NULL)
+	{
+		return bitboard_split_victim_area(g, t, victim, pos, starts, top);
+	}
+	uint64_t neighbours[NEIGHBOURS];
+	uint32_t neighbours_size = 0;
+	set_temp_fields_array(g, t, victim, pos, neighbours, &neighbours_size);
+	uint32_t areas = 0;
+	bool visited = true;
+	*top = 0;
+	for(uint32_t i = 0; i < neighbours_size && visited; i++)
+	{
+		if(get_cell(g, neighbours[i]) == victim)
+		{
+			starts[areas] = *top;
+			areas++;
+			visited = visit_area_field(g, victim, neighbours[i], top);
+			for(uint64_t j = starts[areas-1]; j < *top && visited; j++)
+			{
+				visited = visit_area_neighbours(g, t, victim,
+												(g->area_stack)[j], top);
+			}
+		}
+	}
+	if(!visited)
+	{
+		restore_victim_area(g, victim, *top);
+		return UINT32_MAX;
+	}
+	return areas;
+}
+
+/** @brief Przywraca pionki gracza @p victim na pola odłożone na stos przez
+ * funkcję @ref split_victim_area i buduje od nowa powiązania między polami
+ * każdego z wyznaczonych obszarów, dodając je do zbioru obszarów gracza,
+ * o ile zbiory te są utrzymywane.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] victim 	– numer gracza
+ * @param[in] starts 	– tablica indeksów stosu, od których zaczynają
+ *						  się kolejne obszary
+ * @param[in] areas 	– liczba obszarów
+ * @param[in] top 		– liczba pól znajdujących się na stosie
+ */
+static void relabel_victim_areas(gamma_t * g, uint32_t victim, uint64_t starts[],
+									uint32_t areas, uint64_t top)
+{
+	for(uint32_t i = 0; i < areas; i++)
+	{
+		uint64_t end = (i + 1 < areas) ? starts[i+1] : top;
+		uint64_t root = (g->area_stack)[starts[i]];
+		area_record area = single_area(g, root);
+		for(uint64_t j = starts[i]; j < end; j++)
+		{
+			uint64_t pos = (g->area_stack)[j];
+			set_cell(g, pos, victim);
+			change_parent(g, pos, root);
+			change_rank(g, pos, 0);
+			if(j > starts[i])
+			{
+				merge_area(&area, single_area(g, pos));
+			}
+		}
+		if(end - starts[i] > 1)
+		{
+			change_rank(g, root, 1);
+		}
+		if(g->area_sets != NULL
+			&& !put_area(&(g->area_sets)[player_index(g, victim)], root, area))
+		{
+			drop_area_sets(g);
+		}
+	}
+}
+
+/** @brief Przebudowuje strukturę obszarów wokół pól tablicy
+ * @p stale_fields: przeszukuje obszary graczy przyległe do tych pól,
+ * oznaczając odwiedzone pola na planszy jako wolne, a następnie przywraca
+ * pionki i podpina pola każdego obszaru pod jedno z nich. Każdy obszar
+ * przeszukiwany jest raz, niezależnie od liczby złotych ruchów, które go
+ * podzieliły. Gdy nie uda się zaalokować pamięci, przebudowuje strukturę
+ * obszarów całej planszy.
+ * @param[in,out] g 	– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ */
+TOPOLOGY_SHARED void refresh_stale_areas(gamma_t * g, const topology * t)
+{
+	uint64_t starts[NEIGHBOURS * STALE_FIELDS_MAX];
+	uint32_t first[STALE_FIELDS_MAX + 1];
+	uint32_t areas = 0;
+	uint64_t top = 0;
+	bool visited = true;
+	bool begun = write_begin(g);
+	for(uint32_t i = 0; i < g->stale_size; i++)
+	{
+		first[i] = areas;
+		uint32_t victim = (g->stale_fields)[i].victim;
+		uint64_t pos = (g->stale_fields)[i].pos;
+		uint64_t around[NEIGHBOURS];
+		neighbours_of(g, t, pos, around);
+		for(uint32_t d = 0; d < t->neighbours && visited; d++)
+		{
+			if(!is_on_field(g, around[d], victim))
+			{
+				continue;
+			}
+			starts[areas++] = top;
+			visited = visit_area_field(g, victim, around[d], &top);
+			for(uint64_t j = starts[areas-1]; j < top && visited; j++)
+			{
+				visited = visit_area_neighbours(g, t, victim,
+												(g->area_stack)[j], &top);
+			}
+		}
+	}
+	first[g->stale_size] = areas;
+	for(uint32_t i = 0; i < g->stale_size; i++)
+	{
+		uint32_t count = first[i+1] - first[i];
+		uint64_t end = (first[i+1] < areas) ? starts[first[i+1]] : top;
+		for(uint64_t j = starts[first[i]]; !visited && count > 0 && j < end; j++)
+		{
+			set_cell(g, (g->area_stack)[j], (g->stale_fields)[i].victim);
+		}
+		if(visited && count > 0)
+		{
+			relabel_victim_areas(g, (g->stale_fields)[i].victim,
+									starts + first[i], count, end);
+		}
+	}
+	g->stale_size = 0;
+	if(!visited)
+	{
+		update_board_golden(g, t);
+	}
+	write_end(g, begun);
+}
+
+/** @brief Sprawdza, czy wśród pól tablicy @p stale_fields jest pole,
+ * z którego zdjęto pionek gracza @p player, czyli czy struktura obszarów
+ * tego gracza może nie odpowiadać planszy.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] player 	– numer gracza
+ * @return Wartość @p true, gdy obszary gracza wymagają przebudowy,
+ * a @p false w przeciwnym wypadku.
+ */
+static inline bool has_stale_areas(gamma_t * g, uint32_t player)
+{
+	for(uint32_t i = 0; i < g->stale_size; i++)
+	{
+		if((g->stale_fields)[i].victim == player)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/** @brief Przebudowuje strukturę obszarów wokół pól tablicy
+ * @p stale_fields, jeśli jest wśród nich pole, z którego zdjęto pionek
+ * gracza @p player. Wywoływana przed odczytaniem obszarów gracza.
+ * @param[in,out] g 	– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– numer gracza
+ */
+TOPOLOGY_KERNEL void refresh_player_areas(gamma_t * g, const topology * t,
+																uint32_t player)
+{
+	if(has_stale_areas(g, player))
+	{
+		refresh_stale_areas(g, t);
+	}
+}
+
+/** @brief Szacuje z góry, na ile obszarów rozpadnie się obszar gracza
+ * @p victim po zdjęciu pionka z pola @p pos. Bierze pod uwagę jedynie pola
+ * otaczające dane pole - sąsiedzi połączeni przez pionki gracza na
+ * otaczających polach na pewno pozostaną w jednym obszarze, więc liczone są
+ * spójne fragmenty pionków gracza na tych polach, zawierające sąsiada pola.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza
+ * @param[in] pos 		– numer pola
+ * @return Górne ograniczenie liczby obszarów gracza @p victim przyległych
+ * do pola po zdjęciu z niego pionka.
+ */
+TOPOLOGY_KERNEL uint32_t local_areas_around(gamma_t * g, const topology * t,
+												uint32_t victim, uint64_t pos)
+{
+	uint32_t taken = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < RING_SIZE; i++)
+	{
+		if((t->ring & (1 << i)) != 0)
+		{
+			uint64_t ring_pos = shifted_pos(g, pos, ring_dx[i], ring_dy[i]);
+			taken |= (uint32_t) is_on_field(g, ring_pos, victim) << i;
+		}
+	}
+	uint32_t sides = taken & t->ring_sides;
+	uint32_t areas = 0;
+	while(sides != 0)
+	{
+		uint32_t area = 0;
+		uint32_t grown = sides & (~sides + 1);
+		while(grown != area)
+		{
+			area = grown;
+			for(uint32_t i = 0; i < RING_SIZE; i++)
+			{
+				if((area & (1 << i)) != 0)
+				{
+					grown |= t->ring_links[i] & taken;
+				}
+			}
+		}
+		sides &= ~area;
+		areas++;
+	}
+	return areas;
+}
+
+/** @brief Wykonuje zwykły ruch gracza na pole o podanym numerze,
+ * o ile jest on legalny. Na planszach z bitmapami ruch gracza, który nie
+ * może zająć kolejnego obszaru, na pole izolowane odrzucany jest przed
+ * odczytaniem otoczenia pola.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player 		– poprawny numer gracza
+ * @param[in] pos 			– numer pola na planszy
+ * @return Wartość @p true, gdy ruch został wykonany, a @p false, gdy
+ * ruch jest nielegalny.
+ */
+TOPOLOGY_KERNEL bool exec_move(gamma_t * g, const topology * t, uint32_t player,
+																uint64_t pos)
+{
+	if(!is_field_free(g, pos) || !sparse_reserve(g, 1)
+		|| !ensure_player(g, player))
+	{
+		return false;
+	}
+	refresh_player_areas(g, t, player);
+	bool check_areas = can_have_more_areas(g, player);
+	if(g->bitboards != NULL && !check_areas
+		&& bitboard_field_isolated(g, t, player, pos))
+	{
+		return false;
+	}
+	neighbourhood n;
+	gather_neighbourhood(g, t, pos, &n);
+	if(check_areas || g->bitboards != NULL || !is_isolated_in(t, &n, player))
+	{
+		bool begun = write_begin(g);
+		update_after_move(g, t, player, pos, &n);
+		write_end(g, begun);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool gamma_move(gamma_t * g, uint32_t player, uint32_t x, uint32_t y)
+{
+	if(g != NULL && is_player_in_range(g, player) && check_coordinates(g, x, y))
+	{
+		return g->engine->move(g, player, convert_pos(g, x, y));
+	}
+	else
+	{
+		return false;
+	}
+}
+
+/** @brief Funkcja wykrywająca przypadek, gdy gracz chce zająć w złotym ruchu
+ * pionek odizolowany od obszarów przez siebie posiadanych, gdy nie ma
+ * możliwości zajęcia kolejnego obszaru. W szczególnych przypadkach
+ * znacznie skraca czas wykonania funkcji exec_golden
+ * (gdy ruch nie może zostać wykonany z opisanego powodu).
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] executor  – numer gracza chcącego wykonać
+ *						  złoty ruch
+ * @param[in] pos 		– numer pola, które chce przejąć gracz @p executor
+ * @return Wartość @p true, gdy nie zachodzi opisany warunek
+ * uniemożliwiający wykonanie złotego ruchu, a wartość @p false,
+ * gdy zachodzi i wówczas złoty ruch jest niemożliwy.
+ */
+TOPOLOGY_KERNEL bool initial_golden_check(gamma_t * g, const topology * t,
+												uint32_t executor, uint64_t pos)
+{
+	if(is_field_isolated(g, t, executor, pos) && !can_have_more_areas(g, executor))
+	{
+		return false;
+	}
+	else
+	{
+		return true;
+	}
+}
+
+/** @brief Przywraca zawartość pola planszy zapisaną w dzienniku zmian,
+ * aktualizując bitmapy pól, zbiory wolnych pól przyległych do pól graczy
+ * i zbiory pól innych graczy przyległych do ich pól.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] pos 		– numer pola
+ * @param[in] player 	– poprzednia zawartość pola
+ */
+TOPOLOGY_KERNEL void undo_cell(gamma_t * g, const topology * t, uint64_t pos,
+																uint64_t player)
+{
+	if(g->bitboards != NULL)
+	{
+		uint64_t current = get_cell(g, pos);
+		if(is_player_in_range(g, current))
+		{
+			bitboard_set(g, current, pos, false);
+		}
+		bitboard_set(g, 0, pos, player != 0);
+		if(is_player_in_range(g, player))
+		{
+			bitboard_set(g, player, pos, true);
+		}
+	}
+	uint64_t previous = get_cell(g, pos);
+	set_cell(g, pos, player);
+	g->hash ^= zobrist_cell(pos, previous) ^ zobrist_cell(pos, player);
+	if(g->adjacent_sets != NULL)
+	{
+		refresh_adjacent_sets(g, t, pos, previous);
+	}
+	if(g->border_sets != NULL)
+	{
+		refresh_border_sets(g, t, pos, previous);
+	}
+}
+
+/** @brief Cofa zmiany zapisane w dzienniku od ostatniego wpisu
+ * @ref UNDO_MOVE. Nie usuwa zbiorów obszarów graczy, dlatego może zostać
+ * użyta jedynie do odrzucenia zmian, po których zbiory te nie zostały
+ * jeszcze zaktualizowane.
+ * @param[in,out] g 	– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @return Wartość @p true, gdy cofnięto zmiany, a @p false, gdy dziennik
+ * jest pusty.
+ */
+TOPOLOGY_KERNEL bool undo_records(gamma_t * g, const topology * t)
+{
+	if(g->undo_size == 0)
+	{
+		return false;
+	}
+	while(true)
+	{
+		undo_record record = (g->undo_log)[--g->undo_size];
+		switch(record.kind)
+		{
+			case UNDO_MOVE:
+			{
+				g->board_version++;
+				return true;
+			}
+			case UNDO_CELL:
+			{
+				undo_cell(g, t, record.index, record.value);
+				break;
+			}
+			case UNDO_PARENT:
+			{
+				set_parent(g, record.index, record.value);
+				break;
+			}
+			case UNDO_RANK:
+			{
+				set_rank(g, record.index, (uint8_t) record.value);
+				break;
+			}
+			case UNDO_AREAS:
+			{
+				STORE_SHARED((g->areas_array)[player_index(g, record.index + 1)],
+													(uint32_t) record.value);
+				break;
+			}
+			case UNDO_OCCUPIED:
+			{
+				STORE_SHARED((g->occupied_fields_array)
+								[player_index(g, record.index + 1)], record.value);
+				break;
+			}
+			case UNDO_FREE:
+			{
+				STORE_SHARED((g->free_neighbours)[player_index(g, record.index + 1)],
+																record.value);
+				break;
+			}
+			case UNDO_GOLDEN:
+			{
+				bool * used = &(g->golden_used)[player_index(g, record.index + 1)];
+				if(*used != (bool) record.value)
+				{
+					g->hash ^= zobrist_golden(record.index + 1);
+				}
+				*used = (bool) record.value;
+				break;
+			}
+			default:
+			{
+				STORE_SHARED(g->busy_fields_count, record.value);
+				break;
+			}
+		}
+	}
+}
+
+/** @brief Wyznacza różne główne pola obszarów gracza @p player
+ * przyległych do pola o podanym numerze.
+ * @param[in] g 				  – wskaźnik na strukturę gry
+ * @param[in] t 				  – kształt sąsiedztwa pól
+ * @param[in] player 			  – numer gracza
+ * @param[in] pos 				  – numer pola
+ * @param[out] roots 			  – tablica rozmiaru @ref NEIGHBOURS na główne pola
+ * @return Liczba różnych głównych pól.
+ */
+TOPOLOGY_KERNEL uint32_t roots_around(gamma_t * g, const topology * t,
+								uint32_t player, uint64_t pos, uint64_t roots[])
+{
+	uint64_t around[NEIGHBOURS];
+	neighbours_of(g, t, pos, around);
+	uint32_t roots_size = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t k = 0; k < t->neighbours; k++)
+	{
+		if(!is_on_field(g, around[k], player))
+		{
+			continue;
+		}
+		uint64_t root = find_field(g, around[k]);
+		bool different = true;
+		for(uint32_t j = 0; j < roots_size && different; j++)
+		{
+			different = (roots[j] != root);
+		}
+		if(different)
+		{
+			roots[roots_size++] = root;
+		}
+	}
+	return roots_size;
+}
+
+/** @brief Odpowiada za wykonanie złotego ruchu, uprzednio
+ * sprawdzając, czy jest legalny względem zarówno gracza
+ * @p executor, jak i gracza, którego pole chce zająć
+ * gracz @p executor. Gdy otoczenie pola przesądza, że obszar gracza
+ * tracącego pionek nie rozpadnie się, a zapisywanie ruchów jest wyłączone,
+ * przebudowa struktury jego obszarów jest odkładana.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] executor 	– numer gracza wykonującego złoty ruch
+ * @param[in] pos 		– numer pola, na które gracz @p executor chce
+ *						  wykonać złoty ruch
+ * @return Wartość @p true, gdy ruch jest legalny; jednocześnie jest on
+ * wykonany w ciele funkcji, a wartość @p false, gdy ruch nie jest legalny i
+ * wówczas nic się nie dzieje (przy włączonym zapisywaniu ruchów cofane są
+ * również zmiany powiązań między polami wykonane podczas sprawdzania)
+ */
+TOPOLOGY_KERNEL bool exec_golden(gamma_t * g, const topology * t,
+												uint32_t executor, uint64_t pos)
+{
+	if(g != NULL && !is_field_free(g, pos) && !is_on_field(g, pos, executor))
+	{
+		uint32_t victim = get_cell(g, pos);
+		bool quick_check_executor = initial_golden_check(g, t, executor, pos);
+		if(!quick_check_executor || !ensure_player(g, executor))
+		{
+			return false;
+		}
+		bool begun = write_begin(g);
+		refresh_player_areas(g, t, executor);
+		if(g->stale_size == STALE_FIELDS_MAX)
+		{
+			refresh_stale_areas(g, t);
+		}
+		log_move(g);
+		uint64_t starts[NEIGHBOURS];
+		uint64_t top = 0;
+		uint64_t vic_root = (g->area_sets != NULL) ? find_field(g, pos) : pos;
+		uint32_t vic_around = local_areas_around(g, t, victim, pos);
+		bool deferred = (!g->undo_enabled && g->area_sets == NULL
+											&& vic_around <= 1);
+		if(!deferred)
+		{
+			refresh_player_areas(g, t, victim);
+		}
+		set_cell(g, pos, 0);
+		if(!deferred)
+		{
+			vic_around = split_victim_area(g, t, victim, pos, starts, &top);
+		}
+		bool rebuilt = (vic_around == UINT32_MAX);
+		if(rebuilt)
+		{
+			update_board_golden(g, t);
+			vic_around = player_areas_around(g, t, victim, pos);
+		}
+		if(area_check_golden(g, t, executor, victim, vic_around, pos))
+		{
+			log_change(g, UNDO_CELL, pos, victim);
+			log_change(g, UNDO_GOLDEN, executor - 1, false);
+			log_player(g, executor);
+			log_player(g, victim);
+			area_record taken;
+			if(g->area_sets != NULL)
+			{
+				take_area(&(g->area_sets)[player_index(g, victim)],
+														vic_root, &taken);
+			}
+			if(deferred)
+			{
+				(g->stale_fields)[g->stale_size++] = (stale_field) {pos, victim};
+			}
+			else if(!rebuilt)
+			{
+				relabel_victim_areas(g, victim, starts, vic_around, top);
+			}
+			change_parent(g, pos, pos);
+			change_rank(g, pos, 0);
+			update_player_golden(g, t, executor, pos, true,
+								player_areas_around(g, t, executor, pos));
+			update_player_golden(g, t, victim, pos, false, vic_around);
+			set_cell(g, pos, executor);
+			g->hash ^= zobrist_cell(pos, victim) ^ zobrist_cell(pos, executor)
+												^ zobrist_golden(executor);
+			if(g->bitboards != NULL)
+			{
+				bitboard_set(g, victim, pos, false);
+				bitboard_set(g, executor, pos, true);
+			}
+			if(g->border_sets != NULL)
+			{
+				refresh_border_sets(g, t, pos, victim);
+			}
+			uint64_t roots[NEIGHBOURS];
+			uint32_t roots_size = (g->area_sets != NULL)
+								? roots_around(g, t, executor, pos, roots) : 0;
+			union_field(g, t, pos);
+			if(g->area_sets != NULL)
+			{
+				join_areas(g, executor, pos, roots, roots_size,
+													find_field(g, pos));
+			}
+			g->board_version++;
+			write_end(g, begun);
+			return true;
+		}
+		else
+		{
+			if(!rebuilt && !deferred)
+			{
+				restore_victim_area(g, victim, top);
+			}
+			set_cell(g, pos, victim);
+			if(!deferred)
+			{
+				union_field(g, t, pos);
+			}
+			undo_records(g, t);
+			write_end(g, begun);
+			return false;
+		}
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool gamma_golden_move(gamma_t * g, uint32_t player, uint32_t x, uint32_t y)
+{
+	if(g != NULL && is_player_in_range(g, player) && check_coordinates(g, x, y)
+											&& gamma_golden_possible(g, player))
+	{
+		return g->engine->golden_move(g, player, convert_pos(g, x, y));
+	}
+	else
+	{
+		return false;
+	}
+}
+
+/** Liczba ruchów, o którą pobieranie pól planszy z wyprzedzeniem
+ wyprzedza wykonywanie ruchów w funkcjach wsadowych */
+#define BATCH_PREFETCH_DISTANCE 8
+
+/** Liczba ruchów sprawdzanych jednym przejściem przed ich wykonaniem;
+ fragment wsadu tej długości mieści się w pamięci podręcznej L1 */
+#define BATCH_CHUNK 256
+
+/** @brief Sprawdza poprawność parametrów kolejnych ruchów z wsadu,
+ * zanim którykolwiek z nich zostanie wykonany.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] moves 	– tablica ruchów
+ * @param[in] n 		– liczba ruchów
+ * @return Liczba początkowych ruchów tablicy, których numer gracza
+ * i współrzędne pola są poprawne.
+ */
+static size_t count_valid_moves(gamma_t * g, const gamma_move_t * moves,
+																size_t n)
+{
+	size_t i = 0;
+	while(i < n && is_player_in_range(g, moves[i].player)
+			&& check_coordinates(g, moves[i].x, moves[i].y))
+	{
+		i++;
+	}
+	return i;
+}
+
+/** @brief Zleca pobranie z wyprzedzeniem wierszy planszy i rodziców pól,
+ * które odczyta ruch z wsadu: wiersza pola i wierszy sąsiednich.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] move 		– wskaźnik na opis ruchu o sprawdzonych parametrach
+ */
+static inline void prefetch_batch_move(gamma_t * g, const gamma_move_t * move)
+{
+#if defined(__GNUC__)
+	if(g->sparse_entries == NULL)
+	{
+		const char * cells = g->game_array;
+		const char * parents = g->parent_array;
+		uint64_t pos = convert_pos(g, move->x, move->y);
+		uint64_t rows[3] = {storage_index(g, pos - g->stride),
+							storage_index(g, pos),
+							storage_index(g, pos + g->stride)};
+		for(uint32_t i = 0; i < 3; i++)
+		{
+			__builtin_prefetch(cells + rows[i] * g->cell_bytes);
+			__builtin_prefetch(parents + rows[i] * g->parent_bytes);
+		}
+	}
+#else
+	(void) g;
+	(void) move;
+#endif
+}
+
+/** @brief Wykonuje kolejno ruchy z wsadu. Parametry ruchów sprawdzane są
+ * jednym przejściem dla każdego fragmentu wsadu długości @ref BATCH_CHUNK
+ * przed wykonaniem jego ruchów, z pominięciem wskaźnika na strukturę gry,
+ * więc pętla wykonująca ruchy ich nie sprawdza. Ruch o niepoprawnych
+ * parametrach kończy fragment; następny zaczyna się za nim. Złote ruchy
+ * wykonuje funkcja silnika gry, by nie powielać w tej funkcji kodu
+ * złotego ruchu.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] moves 	– tablica ruchów
+ * @param[in] n 		– liczba ruchów
+ * @param[out] results 	– tablica wyników ruchów lub NULL
+ * @param[in] golden 	– czy ruchy są złotymi ruchami
+ * @return Liczba wykonanych ruchów.
+ */
+TOPOLOGY_KERNEL size_t exec_batch(gamma_t * g, const topology * t,
+			const gamma_move_t * moves, size_t n, bool * results, bool golden)
+{
+	size_t executed = 0;
+	size_t i = 0;
+	while(i < n)
+	{
+		size_t chunk = (n - i < BATCH_CHUNK) ? n - i : BATCH_CHUNK;
+		size_t valid = count_valid_moves(g, moves + i, chunk);
+		size_t end = i + valid;
+		for(; i < end; i++)
+		{
+			if(i + BATCH_PREFETCH_DISTANCE < end)
+			{
+				prefetch_batch_move(g, &moves[i + BATCH_PREFETCH_DISTANCE]);
+			}
+			uint32_t player = moves[i].player;
+			uint64_t pos = convert_pos(g, moves[i].x, moves[i].y);
+			bool done = false;
+			if(!golden)
+			{
+				done = exec_move(g, t, player, pos);
+			}
+			else if(!(g->golden_used)[player_index(g, player)])
+			{
+				done = g->engine->golden_move(g, player, pos);
+			}
+			if(results != NULL)
+			{
+				results[i] = done;
+			}
+			executed += done;
+		}
+		if(valid < chunk)
+		{
+			if(results != NULL)
+			{
+				results[i] = false;
+			}
+			i++;
+		}
+	}
+	return executed;
+}
+
+size_t gamma_move_batch(gamma_t * g, const gamma_move_t * moves, size_t n,
+																bool * results)
+{
+	if(g == NULL || (moves == NULL && n > 0))
+	{
+		return 0;
+	}
+	return g->engine->batch(g, moves, n, results, false);
+}
+
+size_t gamma_golden_move_batch(gamma_t * g, const gamma_move_t * moves,
+												size_t n, bool * results)
+{
+	if(g == NULL || (moves == NULL && n > 0))
+	{
+		return 0;
+	}
+	return g->engine->batch(g, moves, n, results, true);
+}
+
+/** @brief Sprawdza, czy gracz @p victim po utracie pionka nie będzie
+ * posiadał zbyt wielu obszarów.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] victim 	– numer gracza, którego pionek jest zdejmowany
+ * @param[in] split 	– liczba obszarów gracza @p victim przyległych do pola
+ *						  po zdjęciu z niego pionka
+ * @return Wartość @p true, gdy liczba obszarów gracza @p victim nie
+ * przekroczy dopuszczalnej, a @p false w przeciwnym wypadku.
+ */
+static inline bool is_split_allowed(gamma_t * g, uint32_t victim, uint32_t split)
+{
+	return ((g->areas_array)[player_index(g, victim)] + split - 1
+										<= g->maximum_area_count);
+}
+
+/** @brief Wyznacza numer sąsiada pola o podanym numerze.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] pos 		– numer pola
+ * @param[in] direction – numer kierunku, liczba nieujemna mniejsza
+ *						  od liczby sąsiadów pola @p neighbours
+ * @return Numer sąsiada, być może będącego polem ramki.
+ */
+TOPOLOGY_KERNEL uint64_t neighbour_pos(gamma_t * g, const topology * t,
+											uint64_t pos, uint32_t direction)
+{
+	return shifted_pos(g, pos, t->dx[direction], t->dy[direction]);
+}
+
+/** Znacznik wpisu tablicy @p visits pola, dla którego wyznaczono już liczbę
+	obszarów, na które rozpadnie się jego obszar po zdjęciu z niego pionka */
+#define SPLIT_KNOWN ((uint64_t) 1 << 63)
+
+/** Liczba najmłodszych bitów wpisu ze znacznikiem @ref SPLIT_KNOWN,
+	przechowujących liczbę obszarów; starsze bity przechowują początkową
+	wartość licznika @p visit_counter przeszukiwania, które go zapisało */
+#define SPLIT_SHIFT 4
+
+/** @brief Sprawdza, czy wpis tablicy @p visits zapisało bieżące
+ * przeszukiwanie obszarów.
+ * @param[in] entry 	– wpis tablicy @p visits
+ * @param[in] base 		– wartość licznika @p visit_counter na początku
+ *						  bieżącego przeszukiwania
+ * @return Wartość @p true, gdy pole zostało odwiedzone w bieżącym
+ * przeszukiwaniu, a @p false, gdy wpis jest pusty lub pochodzi
+ * z wcześniejszego przeszukiwania.
+ */
+static inline bool is_visited(uint64_t entry, uint64_t base)
+{
+	if((entry & SPLIT_KNOWN) != 0)
+	{
+		return ((entry & ~SPLIT_KNOWN) >> SPLIT_SHIFT == base);
+	}
+	return (entry > base);
+}
+
+/** @brief Odkłada ramkę na stos przeszukiwania w głąb @p dfs_stack,
+ * powiększając go w razie potrzeby.
+ * @param[in,out] g 	– wskaźnik na strukturę gry
+ * @param[in,out] top 	– wskaźnik na liczbę ramek na stosie
+ * @param[in] frame 	– odkładana ramka
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool push_dfs_stack(gamma_t * g, uint64_t * top, dfs_frame frame)
+{
+	if(*top == g->dfs_capacity && g->scratch != NULL)
+	{
+		return false;
+	}
+	if(*top == g->dfs_capacity)
+	{
+		uint64_t new_capacity = 2 * g->dfs_capacity + 16;
+		dfs_frame * new_stack = realloc(g->dfs_stack,
+										new_capacity * sizeof(dfs_frame));
+		if(new_stack == NULL)
+		{
+			return false;
+		}
+		g->dfs_stack = new_stack;
+		g->dfs_capacity = new_capacity;
+	}
+	(g->dfs_stack)[(*top)++] = frame;
+	return true;
+}
+
+/** @brief Przeszukuje w głąb obszar gracza @p victim zawierający pole
+ * @p pos. Dla każdego pola obszaru wyznacza (algorytmem Tarjana),
+ * na ile obszarów rozpadnie się obszar po zdjęciu pionka z tego pola,
+ * i zapisuje tę liczbę w tablicy @p visits wraz ze znacznikiem
+ * @ref SPLIT_KNOWN i wartością @p base. Wpisy wcześniejszych przeszukiwań
+ * traktowane są jak puste, więc tablicy nie trzeba zerować.
+ * @param[in,out] g 	– wskaźnik na strukturę gry z przydzieloną
+ *						  tablicą @p visits
+ * @param[in] t 	– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza, którego obszar przeszukujemy
+ * @param[in] pos 		– numer pola
+ * @param[in] base 		– wartość licznika @p visit_counter na początku
+ *						  bieżącego przeszukiwania
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+TOPOLOGY_SHARED bool search_victim_area(gamma_t * g, const topology * t,
+								uint32_t victim, uint64_t pos, uint64_t base)
+{
+	uint64_t * visits = g->visits;
+	uint64_t top = 0;
+	uint64_t visit = ++g->visit_counter;
+	visits[pos] = visit;
+	if(!push_dfs_stack(g, &top, (dfs_frame) {pos, visit, visit, 0, 0}))
+	{
+		return false;
+	}
+	while(top > 0)
+	{
+		dfs_frame * frame = &(g->dfs_stack)[top-1];
+		if(frame->direction < t->neighbours)
+		{
+			uint64_t n_pos = neighbour_pos(g, t, frame->pos, frame->direction);
+			frame->direction++;
+			if(is_on_field(g, n_pos, victim))
+			{
+				if(!is_visited(visits[n_pos], base))
+				{
+					visit = ++g->visit_counter;
+					visits[n_pos] = visit;
+					if(!push_dfs_stack(g, &top,
+								(dfs_frame) {n_pos, visit, visit, 0, 0}))
+					{
+						return false;
+					}
+				}
+				else if(visits[n_pos] < frame->low)
+				{
+					frame->low = visits[n_pos];
+				}
+			}
+		}
+		else
+		{
+			dfs_frame done = *frame;
+			top--;
+			uint32_t split = done.cuts + (top > 0 ? 1 : 0);
+			visits[done.pos] = SPLIT_KNOWN | (base << SPLIT_SHIFT) | split;
+			if(top > 0)
+			{
+				dfs_frame * parent = &(g->dfs_stack)[top-1];
+				if(done.low >= parent->visit)
+				{
+					parent->cuts++;
+				}
+				if(done.low < parent->low)
+				{
+					parent->low = done.low;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/** @brief Znajduje główne pole obszaru, do którego przynależy pole
+ * o podanym numerze, nie modyfikując struktury obszarów.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[in] pos 				– numer pola
+ * @return Numer głównego pola obszaru.
+ */
+static uint64_t find_root(gamma_t * g, uint64_t pos)
+{
+	uint64_t parent = get_parent(g, pos);
+	while(parent != pos)
+	{
+		pos = parent;
+		parent = get_parent(g, pos);
+	}
+	return pos;
+}
+
+/** @brief Liczy różne obszary gracza @p player przyległe do pola
+ * o podanym numerze, nie modyfikując struktury obszarów.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player 		– numer gracza
+ * @param[in] n 			– otoczenie pola
+ * @return Liczba różnych obszarów gracza przyległych do pola.
+ */
+TOPOLOGY_KERNEL uint32_t count_roots_around(gamma_t * g, const topology * t,
+									uint32_t player, const neighbourhood * n)
+{
+	uint64_t roots[NEIGHBOURS];
+	uint32_t roots_size = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
+	{
+		if(n->owner[i] == player)
+		{
+			uint64_t root = find_root(g, n->pos[i]);
+			bool different = true;
+			for(uint32_t j = 0; j < roots_size && different; j++)
+			{
+				different = (roots[j] != root);
+			}
+			if(different)
+			{
+				roots[roots_size++] = root;
+			}
+		}
+	}
+	return roots_size;
+}
+
+/** @struct field_set
+ * Zbiór numerów pól planszy, tablica z haszowaniem otwartym; pole ramki
+ * o numerze 0 oznacza wolne miejsce w tablicy
+ */
+typedef struct field_set
+{
+	uint64_t * slots;
+	/**< Tablica numerów pól */
+	uint64_t capacity;
+	/**< Rozmiar tablicy @p slots, potęga dwójki */
+	uint64_t size;
+	/**< Liczba pól w zbiorze */
+} field_set;
+
+/** @brief Podaje indeks w tablicy zbioru, pod którym znajduje się pole
+ * lub pod którym należy je umieścić.
+ * @param[in] set 		– wskaźnik na zbiór
+ * @param[in] pos 		– numer pola
+ * @return Indeks w tablicy @p slots.
+ */
+static uint64_t field_set_slot(const field_set * set, uint64_t pos)
+{
+	uint64_t slot = hash_field(pos) & (set->capacity - 1);
+	while((set->slots)[slot] != 0 && (set->slots)[slot] != pos)
+	{
+		slot = (slot + 1) & (set->capacity - 1);
+	}
+	return slot;
+}
+
+/** @brief Dodaje pole do zbioru, powiększając go w razie potrzeby.
+ * @param[in,out] set 	– wskaźnik na zbiór
+ * @param[in] pos 		– numer pola, różny od 0
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool field_set_add(field_set * set, uint64_t pos)
+{
+	if(2 * (set->size + 1) > set->capacity)
+	{
+		field_set bigger = {calloc(2 * set->capacity, sizeof(uint64_t)),
+												2 * set->capacity, 0};
+		if(bigger.slots == NULL)
+		{
+			return false;
+		}
+		for(uint64_t i = 0; i < set->capacity; i++)
+		{
+			if((set->slots)[i] != 0)
+			{
+				(bigger.slots)[field_set_slot(&bigger, (set->slots)[i])] =
+															(set->slots)[i];
+				bigger.size++;
+			}
+		}
+		free(set->slots);
+		*set = bigger;
+	}
+	uint64_t slot = field_set_slot(set, pos);
+	if((set->slots)[slot] == 0)
+	{
+		(set->slots)[slot] = pos;
+		set->size++;
+	}
+	return true;
+}
+
+/** @brief Sprawdza, czy pole należy do zbioru.
+ * @param[in] set 		– wskaźnik na zbiór
+ * @param[in] pos 		– numer pola
+ * @return Wartość @p true, gdy pole należy do zbioru, a @p false
+ * w przeciwnym wypadku.
+ */
+static inline bool field_set_contains(const field_set * set, uint64_t pos)
+{
+	return ((set->slots)[field_set_slot(set, pos)] == pos);
+}
+
+/** @brief Przeszukuje wszerz obszary gracza @p victim przyległe do pola
+ * @p pos, pomijając to pole, i liczy, ile z nich jest różnych. Nie
+ * modyfikuje stanu gry; odwiedzone pola przechowuje we własnym zbiorze.
+ * Przeszukiwanie kończy się, gdy odwiedzeni zostaną wszyscy sąsiedzi.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza
+ * @param[in] pos 		– numer pola
+ * @param[in] sides 	– sąsiedzi pola należący do gracza @p victim
+ * @param[in] sides_size – liczba tych sąsiadów
+ * @return Liczba obszarów przyległych do pola po zdjęciu z niego pionka
+ * lub @p UINT32_MAX, gdy nie udało się zaalokować pamięci.
+ */
+TOPOLOGY_SHARED uint32_t search_split(gamma_t * g, const topology * t,
+		uint32_t victim, uint64_t pos, uint64_t sides[], uint32_t sides_size)
+{
+	field_set visited = {calloc(64, sizeof(uint64_t)), 64, 0};
+	uint64_t queue_size = 64;
+	uint64_t * queue = malloc(queue_size * sizeof(uint64_t));
+	bool valid = (visited.slots != NULL && queue != NULL
+								&& field_set_add(&visited, pos));
+	uint32_t areas = 0;
+	uint32_t remaining = sides_size;
+	for(uint32_t i = 0; i < sides_size && remaining > 0 && valid; i++)
+	{
+		if(field_set_contains(&visited, sides[i]))
+		{
+			continue;
+		}
+		areas++;
+		uint64_t head = 0;
+		uint64_t tail = 0;
+		queue[tail++] = sides[i];
+		valid = field_set_add(&visited, sides[i]);
+		remaining--;
+		while(head < tail && remaining > 0 && valid)
+		{
+			uint64_t current = queue[head++];
+			for(uint32_t d = 0; d < t->neighbours && valid; d++)
+			{
+				uint64_t next = neighbour_pos(g, t, current, d);
+				if(!is_on_field(g, next, victim) || field_set_contains(&visited, next))
+				{
+					continue;
+				}
+				for(uint32_t k = 0; k < sides_size; k++)
+				{
+					remaining -= (sides[k] == next);
+				}
+				if(tail == queue_size)
+				{
+					queue_size *= 2;
+					uint64_t * new_queue = realloc(queue, queue_size * sizeof(uint64_t));
+					if(new_queue == NULL)
+					{
+						valid = false;
+						break;
+					}
+					queue = new_queue;
+				}
+				queue[tail++] = next;
+				valid = field_set_add(&visited, next);
+			}
+		}
+	}
+	free(visited.slots);
+	free(queue);
+	return valid ? areas : UINT32_MAX;
+}
+
+/** @brief Wyznacza, na ile obszarów rozpadnie się obszar gracza @p victim
+ * po zdjęciu pionka z pola @p pos, nie modyfikując stanu gry.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] victim 	– numer gracza zajmującego pole
+ * @param[in] pos 		– numer pola
+ * @return Liczba obszarów gracza przyległych do pola po zdjęciu z niego
+ * pionka lub @p UINT32_MAX, gdy nie udało się zaalokować pamięci.
+ */
+TOPOLOGY_KERNEL uint32_t count_victim_split(gamma_t * g, const topology * t,
+												uint32_t victim, uint64_t pos)
+{
+	uint32_t bound = local_areas_around(g, t, victim, pos);
+	if(bound <= 1)
+	{
+		return bound;
+	}
+	if(g->bitboards != NULL)
+	{
+		return bitboard_split_victim_area(g, t, victim, pos, NULL, NULL);
+	}
+	uint64_t sides[NEIGHBOURS];
+	uint32_t sides_size = 0;
+	set_temp_fields_array(g, t, victim, pos, sides, &sides_size);
+	return search_split(g, t, victim, pos, sides, sides_size);
+}
+
+/** @brief Liczy różne obszary gracza @p player przyległe do pola
+ * o podanym numerze, nie modyfikując stanu gry. Gdy struktura obszarów
+ * gracza nie została przebudowana po złotym ruchu, który zdjął jego pionek,
+ * nie odpowiada ona planszy, więc obszary wyznaczane są wtedy
+ * przeszukaniem planszy wokół pola.
+ * @param[in] g 			– wskaźnik na strukturę gry
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @param[in] player 		– numer gracza
+ * @param[in] pos 			– numer pola niezajętego przez gracza
+ * @param[in] n 			– otoczenie pola
+ * @return Liczba różnych obszarów gracza przyległych do pola lub
+ * @p UINT32_MAX, gdy nie udało się zaalokować pamięci.
+ */
+TOPOLOGY_KERNEL uint32_t count_areas_around(gamma_t * g, const topology * t,
+						uint32_t player, uint64_t pos, const neighbourhood * n)
+{
+	if(has_stale_areas(g, player))
+	{
+		return count_victim_split(g, t, player, pos);
+	}
+	return count_roots_around(g, t, player, n);
+}
+
+/** @brief Sprawdza, czy gracz może wykonać złoty ruch na pole o podanym
+ * numerze zajęte przez gracza @p victim, przeszukując obszar, do
+ * którego należy to pole. Wykorzystywana, gdy zabrakło pamięci na
+ * przeszukiwanie funkcją @ref search_victim_area.
+ * @param[in] g - wskaźnik na strukturę gry
+ * @param[in] t - kształt sąsiedztwa pól
+ * @param[in] pos - numer sprawdzanego pola
+ * @param[in] victim - numer gracza zajmującego sprawdzane pole
+ * @return Wartość @p true, gdy gracz @p victim nie przekroczy limitu
+ * obszarów po utracie pionka, a @p false w przeciwnym wypadku.
+ */
+TOPOLOGY_KERNEL bool check_field_golden_possible(gamma_t * g,
+							const topology * t, uint64_t pos, uint32_t victim)
+{
+	uint32_t split = count_victim_split(g, t, victim, pos);
+	return (split != UINT32_MAX && is_split_allowed(g, victim, split));
+}
+
+/** @struct target_search
+ * Stan przeszukiwania obszarów graczy przy wyznaczaniu pól, na które
+ * gracz może wykonać złoty ruch
+ */
+typedef struct target_search
+{
+	uint64_t base;
+	/**< Wartość licznika @p visit_counter na początku wyznaczania pól */
+	bool searchable;
+	/**< Czy obszary można przeszukiwać funkcją @ref search_victim_area */
+} target_search;
+
+/** @brief Sprawdza, czy gracz może wykonać złoty ruch na pole o podanym
+ * numerze. Pola, dla których nie rozstrzyga tego otoczenie pola,
+ * sprawdzane są przeszukiwaniem całego obszaru, wykonywanym co najwyżej
+ * raz dla każdego obszaru.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– numer gracza
+ * @param[in] pos 		– numer pola
+ * @param[in] more_areas – czy gracz może zająć nowy obszar
+ * @param[in,out] search – stan przeszukiwania obszarów
+ * @return Wartość @p true, gdy złoty ruch na pole jest legalny, a @p false
+ * w przeciwnym wypadku.
+ */
+TOPOLOGY_KERNEL bool is_golden_target(gamma_t * g, const topology * t,
+		uint32_t player, uint64_t pos, bool more_areas, target_search * search)
+{
+	uint64_t victim = get_cell(g, pos);
+	if(victim == 0 || victim == player
+		|| (!more_areas && is_field_isolated(g, t, player, pos)))
+	{
+		return false;
+	}
+	bool legal = is_split_allowed(g, victim,
+						local_areas_around(g, t, victim, pos));
+	if(!legal && search->searchable && g->visits == NULL)
+	{
+		g->visits = calloc(padded_size(g), sizeof(uint64_t));
+		search->searchable = (g->visits != NULL);
+	}
+	if(!legal && search->searchable)
+	{
+		claim_scratch(g);
+	}
+	if(!legal && search->searchable
+		&& !is_visited((g->visits)[pos], search->base))
+	{
+		search->searchable = search_victim_area(g, t, victim, pos, search->base);
+	}
+	if(!legal && search->searchable)
+	{
+		legal = is_split_allowed(g, victim, (g->visits)[pos]
+										& (((uint64_t) 1 << SPLIT_SHIFT) - 1));
+	}
+	else if(!legal)
+	{
+		legal = check_field_golden_possible(g, t, pos, victim);
+	}
+	return legal;
 }
 
-/** @brief Sprawdza, czy podany numer gracza jest w zakresie
- * zgodnym z wartością ustawioną w strukturze gry.
- * @p struktury @ref gamma_t.
- * @param[in] g  			 	  – wskaźnik na strukturę gry
- * @param[in] target_player  	  – numer gracza
- * @return Wartość @p true, jeśli dany numer gracza jest poprawny,
- * a @p false w przeciwnym wypadku.
+/** @brief Porównuje numery pól na potrzeby funkcji qsort.
+ * @param[in] first 	– wskaźnik na numer pierwszego pola
+ * @param[in] second 	– wskaźnik na numer drugiego pola
+ * @return Liczba ujemna, zero lub liczba dodatnia, gdy pierwsze pole jest
+ * odpowiednio wcześniej, w tym samym miejscu lub dalej na planszy.
  */
-static bool is_player_in_range(gamma_t * g, uint32_t target_player)
+static int compare_fields(const void * first, const void * second)
 {
-	return (target_player > 0 && target_player <= g->players_count);
+	uint64_t a = *(const uint64_t *) first;
+	uint64_t b = *(const uint64_t *) second;
+	return (a > b) - (a < b);
 }
 
-/** @brief Sprawdza, czy na polu znajduje się pionek wskazanego gracza.
- * @param[in] g 				– wskaźnik na strukturę gry
- * @param[in] x 				– numer kolumny, w której znajduje się
- *								  sprawdzane pole
- * @param[in] y 				– numer wiersza, w którym znajduje się
- * 								  sprawdzane pole
- * @param[in] player 			– gracz, którego pionka
- * 								  obecność na danym polu sprawdzamy
- * @return Wartość @p true, gdy na wskazanym polu znajduje się pionek
- * danego gracza, a @p false w przeciwnym wypadku.
+/** @brief Wyznacza pola, na które gracz może wykonać złoty ruch, w trybie
+ * rzadkim: przegląda jedynie pola tablicy @p sparse_entries, a znalezione
+ * pola porządkuje według numerów przed umieszczeniem ich w buforze.
+ * @param[in] g 		– wskaźnik na strukturę gry w trybie rzadkim
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– numer gracza
+ * @param[out] targets 	– bufor na znalezione pola lub NULL
+ * @param[in] size 		– rozmiar bufora @p targets
+ * @param[in] first_only – czy przerwać po znalezieniu pierwszego pola
+ * @return Liczba znalezionych pól lub 0, gdy nie udało się zaalokować
+ * pamięci.
  */
-static inline bool is_on_field(gamma_t * g, uint32_t x, uint32_t y, uint32_t player)
+TOPOLOGY_SHARED uint64_t iterate_sparse_board(gamma_t * g, const topology * t,
+	uint32_t player, gamma_field_t * targets, uint64_t size, bool first_only)
 {
-	if(check_coordinates(g, x, y))
+	bool more_areas = can_have_more_areas(g, player);
+	target_search search = {g->visit_counter, false};
+	uint64_t * legal = NULL;
+	if(size > 0)
 	{
-		uint64_t pos = convert_pos(g, x, y);
-		return ((g->game_array)[pos] == player);
+		legal = malloc(g->sparse_size * sizeof(uint64_t));
+		if(legal == NULL)
+		{
+			return 0;
+		}
 	}
-	else
+	uint64_t found = 0;
+	for(uint64_t i = 0; i < g->sparse_capacity && !(first_only && found > 0); i++)
 	{
-		return false;
+		uint64_t pos = (g->sparse_entries)[i].pos;
+		if(pos != 0 && is_golden_target(g, t, player, pos, more_areas, &search))
+		{
+			if(legal != NULL)
+			{
+				legal[found] = pos;
+			}
+			found++;
+		}
+	}
+	if(legal != NULL)
+	{
+		qsort(legal, found, sizeof(uint64_t), compare_fields);
+		for(uint64_t i = 0; i < found && i < size; i++)
+		{
+			targets[i] = (gamma_field_t) {legal[i] % g->stride - 1,
+											legal[i] / g->stride - 1};
+		}
 	}
+	free(legal);
+	return found;
 }
 
-/** @brief Sprawdza, czy dany gracz może zająć nowy obszar, czyli
- * czy liczba aktualnie zajętych przez niego obszarów jest
- * mniejsza od dopuszczalnej liczby obszarów w posiadaniu
- * jednego gracza.
- * @param[in] g  			 	  – wskaźnik na strukturę gry
- * @param[in] player        	  – numer gracza
- * @return Wartość @p true, jeśli dany gracz może zająć nowy obszar,
- * a wartość @p false w przeciwnym wypadku
+/** @brief Iteruje po polach zajętych przez graczy innych niż @p player
+ * i wyznacza te, na które gracz może wykonać złoty ruch. Gdy dostępne
+ * są bitmapy pól, w każdym wierszu odwiedzane są jedynie pola zajęte przez
+ * innych graczy (i przyległe do pól gracza, gdy nie może on zająć nowego
+ * obszaru).
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– numer gracza
+ * @param[out] targets 	– bufor na znalezione pola lub NULL
+ * @param[in] size 		– rozmiar bufora @p targets
+ * @param[in] first_only – czy przerwać po znalezieniu pierwszego pola
+ * @return Liczba znalezionych pól.
  */
-static inline bool can_have_more_areas(gamma_t * g, uint32_t player)
+TOPOLOGY_KERNEL uint64_t iterate_board(gamma_t * g, const topology * t,
+	uint32_t player, gamma_field_t * targets, uint64_t size, bool first_only)
 {
-	if(g != NULL)
+	if(g->sparse_entries != NULL)
 	{
-        return (((g->areas_array)[player-1]) < g->maximum_area_count);
+		return iterate_sparse_board(g, t, player, targets, size, first_only);
 	}
-	else
+	bool more_areas = can_have_more_areas(g, player);
+	target_search search = {g->visit_counter, true};
+	uint64_t found = 0;
+	for(uint32_t j = 0; j < g->height && !(first_only && found > 0); j++)
 	{
-		return false;
+		uint64_t candidates = UINT64_MAX;
+		if(g->bitboards != NULL)
+		{
+			uint64_t * own = bitboard_rows(g, player);
+			candidates = bitboard_rows(g, 0)[j] & ~own[j];
+			if(!more_areas)
+			{
+				candidates &= bitboard_dilate(t, own, g->height, j);
+			}
+		}
+		for(uint32_t i = 0; i < g->width && !(first_only && found > 0); i++)
+		{
+			if(g->bitboards != NULL)
+			{
+				if(candidates == 0)
+				{
+					break;
+				}
+				i = lowest_bit(candidates);
+				candidates &= candidates - 1;
+			}
+			bool legal = is_golden_target(g, t, player, convert_pos(g, i, j),
+														more_areas, &search);
+			if(legal && found < size)
+			{
+				targets[found] = (gamma_field_t) {i, j};
+			}
+			found += legal;
+		}
 	}
+	return found;
 }
 
-/** @brief Sprawdza, czy pole o podanych współrzędnych jest wolne
- * @param[in] g  			 	  – wskaźnik na strukturę gry
- * @param[in] x 	  		 	  – numer kolumny, w której znajduje się
- * 				        	   	    sprawdzane pole
- * @param[in] y 	  		 	  – numer wiersza, w którym znajduje się
- * 							   		sprawdzane pole
- * @return Wartość @p true, jeśli na polu o podanych współrzędnych nie znajduje się
- * żaden pionek, a @p false jeśli pole to jest zajęte przez jakiegoś gracza lub
- * wskaźnik @p g to NULL lub podane współrzędne są niepoprawne.
+/** @brief Sprawdza, czy gracz, który nie może zająć nowego obszaru, może
+ * wykonać złoty ruch. Przegląda jedynie zbiór pól innych graczy przyległych
+ * do pól gracza, utrzymywany przez kolejne ruchy; gdy zbiorów tych nie
+ * udało się utworzyć lub gra umieszczona jest w obszarze wywołującego,
+ * gdzie ich budowa wymagałaby przydzielania pamięci, przegląda całą
+ * planszę.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– numer gracza
+ * @return Wartość @p true, gdy gracz może wykonać złoty ruch na któreś pole,
+ * a @p false w przeciwnym wypadku.
  */
-static bool is_field_free(gamma_t * g, uint32_t x, uint32_t y)
+TOPOLOGY_KERNEL bool is_border_target_found(gamma_t * g, const topology * t,
+																uint32_t player)
 {
-	if(g != NULL && check_coordinates(g, x, y))
+	if(g->border_sets == NULL && (g->borrowed || !build_border_sets(g, t)))
 	{
-		uint64_t pos = convert_pos(g, x, y);
-		return ((g->game_array)[pos] == 0);
+		return (iterate_board(g, t, player, NULL, 0, true) > 0);
 	}
-	else
+	const adjacent_set * set = &(g->border_sets)[player_index(g, player)];
+	target_search search = {g->visit_counter, g->sparse_entries == NULL};
+	for(uint64_t i = 0; i < set->size; i++)
 	{
-		return false;
+		if(is_golden_target(g, t, player, (set->fields)[i], false, &search))
+		{
+			return true;
+		}
 	}
+	return false;
 }
 
-/** @brief Łączy pole o podanych współrzędnych z sąsiadującymi polami
- * należącymi do tego samego gracza, o ile wskazane pole jest przez niego
- * zajęte - w przeciwnym wypadku połączenie pól nie następuje.
- * @param[in] g              	  – wskaźnik na strukturę gry
- * @param[in] x 			 	  – numer kolumny, w której 
- *							   	    znajduje się wskazane pole
- * @param[in] y 			 	  – numer wiersza, w którym
- *						   	   		znajduje się wskazane pole
- */
-static void union_field(gamma_t * g, uint32_t x, uint32_t y)
+bool gamma_golden_possible(gamma_t * g, uint32_t player)
 {
-	uint64_t pos = convert_pos(g, x, y);
-	uint32_t current_player = (g->game_array)[pos];
-	if(is_player_in_range(g, current_player))
+	if(g != NULL && is_player_in_range(g, player))
 	{
-		if(x > 0 && is_on_field(g, x - 1, y, current_player))
+		uint64_t index = player_index(g, player);
+		bool from_player = !(g->golden_used)[index];
+		if(!from_player)
 		{
-			connect_fields(g, pos, convert_pos(g, x - 1, y));
+			return false;
 		}
-		if(y > 0 && is_on_field(g, x, y - 1, current_player))
+		bool from_board = (g->busy_fields_count
+							> (g->occupied_fields_array)[index]);
+		if(from_board && can_have_more_areas(g, player))
 		{
-			connect_fields(g, pos, convert_pos(g, x, y - 1));
+			return true;
 		}
-		if((x < g->width - 1) && is_on_field(g, x + 1, y, current_player))
+		else if(from_board)
 		{
-			connect_fields(g, pos, convert_pos(g, x + 1, y));
+			uint64_t cached = (g->golden_possible_cache)[index];
+			if((cached >> 1) == g->board_version)
+			{
+				return (cached & 1);
+			}
+			bool possible = g->engine->border_target_found(g, player);
+			(g->golden_possible_cache)[index] = (g->board_version << 1) | possible;
+			return possible;
 		}
-		if((y < g->height - 1) && is_on_field(g, x, y + 1, current_player))
+		else
 		{
-			connect_fields(g, pos, convert_pos(g, x, y + 1));
+			return false;
 		}
 	}
+	else
+	{
+		return false;
+	}
 }
 
-/** @brief Sprawdza, czy pole o podanych współrzędnych jest izolowane
- * względem gracza o numerze @p player. Przez pole izolowane względem gracza
- * rozumiemy takie pole, że na żadnym z sąsiadujących z nim pól nie znajduje
- * się pionek należący do wskazanego gracza.
- * @param[in] g  			 	  – wskaźnik na strukturę gry
- * @param[in] player  		 	  – numer gracza
- * @param[in] x 	  		 	  – numer kolumny, w której znajduje się
- * 							   		docelowe pole
- * @param[in] y 	  		 	  – numer wiersza, w którym znajduje się
- * 									docelowe pole
- */
-static bool is_field_isolated(gamma_t * g, uint32_t player, 
-									uint32_t x, uint32_t y)
+uint64_t gamma_golden_targets(gamma_t * g, uint32_t player,
+							gamma_field_t * targets, uint64_t size)
 {
-	bool check_upper = true;
-	bool check_lower = true;
-	bool check_right = true;
-	bool check_left = true;
-	if(y < g->height - 1)
+	if(g != NULL && is_player_in_range(g, player) && (targets != NULL || size == 0)
+				&& !(g->golden_used)[player_index(g, player)])
 	{
-		check_upper = !is_on_field(g, x, y + 1, player);
+		return g->engine->targets(g, player, targets, size, false);
 	}
-	if(y > 0)
+	else
 	{
-		check_lower = !is_on_field(g, x, y - 1, player);
+		return 0;
 	}
-	if(x > 0)
+}
+
+bool gamma_adjacent_begin(gamma_t * g, uint32_t player,
+							gamma_adjacent_iterator_t * it)
+{
+	if(g == NULL || it == NULL || !is_player_in_range(g, player))
 	{
-		check_left = !is_on_field(g, x - 1, y, player);
+		return false;
 	}
-	if(x < g->width - 1)
+	if(g->adjacent_sets == NULL && !g->engine->build_adjacent_sets(g))
 	{
-		check_right = !is_on_field(g, x + 1, y, player);
+		return false;
 	}
-	return (check_left && check_upper && check_right && check_lower);
+	*it = (gamma_adjacent_iterator_t) {g, player, 0};
+	return true;
 }
 
-/** @brief Sprawdza, czy pole o podanych współrzędnych nowym wolnym
- * polem sąsiadującym z polem należącym do gracza @p player.
- * @param[in] g 				– wskaźnik na strukturę gry
- * @param[in] player 			– numer gracza
- * @param[in] x 				– numer kolumny, w której znajduje się
- * 								  sprawdzane pole
- * @param[in] y 				– numer wiersza, w którym znajduje się
- *								  sprawdzane pole
- * @return Wartość @p true, jeśli dane pole jest nowe, a @p false jeśli
- * pole to jest już uznane za wolne pole sąsiadujące z polem należącym
- * do gracza @p player.
- */
-static inline bool is_new_free_neighbour(gamma_t * g, uint32_t player,
-													uint32_t x, uint32_t y)
+bool gamma_adjacent_next(gamma_adjacent_iterator_t * it, gamma_field_t * field)
 {
-	return (is_field_free(g, x, y) && is_field_isolated(g, player, x, y));
+	if(it == NULL || field == NULL || it->g == NULL
+		|| it->g->adjacent_sets == NULL)
+	{
+		return false;
+	}
+	const adjacent_set * set =
+					&(it->g->adjacent_sets)[player_index(it->g, it->player)];
+	if(it->index >= set->size)
+	{
+		return false;
+	}
+	uint64_t pos = (set->fields)[it->index++];
+	*field = (gamma_field_t) {pos % it->g->stride - 1, pos / it->g->stride - 1};
+	return true;
 }
 
-/** @brief Aktualizuje pomocniczą tablicę wyznaczającą liczbę różnych graczy
- * sąsiadujących z polem, którego współrzędne przekazane zostały funkcji
- * wywołującej @ref update_neighbours_touching_fields.
- * @param[in] array[] 			– aktualizowana tablica
- * @param[in] *array_size 		– rozmiar tablicy
- * @param[in] target_value		– liczba, którą chcemy umieścić w tablicy
- */
-static void update_temp_neighbour_array(uint32_t array[], uint32_t * array_size, 
-									uint32_t target_value)
+uint32_t gamma_areas(gamma_t * g, uint32_t player)
 {
-	bool different = true;
-	for(uint32_t i = 0; i < *array_size; i++)
-	{
-		if(array[i] == target_value)
-		{
-			different = false;
-		}
-	}
-	if(different)
+	if(g == NULL || !is_player_in_range(g, player))
 	{
-		array[*array_size] = target_value;
-		(*array_size)++;
+		return 0;
 	}
+	return (g->areas_array)[player_index(g, player)];
 }
-					
-/** @brief Aktualizuje liczbę wolnych pól przyległych do pól
- * zajętych przez gracza @p player.
+
+/** @brief Tworzy zbiory obszarów graczy na podstawie zawartości planszy,
+ * przeglądając ją jednokrotnie; w trybie rzadkim przeglądane są jedynie
+ * pola tablicy @p sparse_entries. Wcześniej przebudowuje nieaktualną
+ * strukturę obszarów wokół pól tablicy @p stale_fields.
  * @param[in] g 			– wskaźnik na strukturę gry
- * @param[in] player 		– numer gracza
- * @param[in] increase		– wartość @p true, gdy zwiększamy,
- *							  a @p false, gdy zmniejszamy
- *							  (liczbę z opisu funkcji)
+ * @param[in] t 			– kształt sąsiedztwa pól
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
  */
-static inline void update_neighbours_array(gamma_t * g, uint32_t player, bool increase)
+TOPOLOGY_SHARED bool build_area_sets(gamma_t * g, const topology * t)
 {
-	if(increase)
+	refresh_stale_areas(g, t);
+	g->area_sets = calloc(player_slots(g), sizeof(area_set));
+	if(g->area_sets == NULL)
 	{
-		(g->free_neighbours)[player-1]++;
+		return false;
 	}
-	else
+	uint64_t board_size = (g->sparse_entries != NULL) ? g->sparse_capacity
+														: padded_size(g);
+	for(uint64_t i = 0; i < board_size; i++)
 	{
-		(g->free_neighbours)[player-1]--;
+		uint64_t pos = (g->sparse_entries != NULL)
+								? (g->sparse_entries)[i].pos : i;
+		uint64_t player = (pos != 0) ? get_cell(g, pos) : 0;
+		if(!is_player_in_range(g, player))
+		{
+			continue;
+		}
+		area_set * set = &(g->area_sets)[player_index(g, player)];
+		uint64_t root = find_root(g, pos);
+		area_record * area = find_area(set, root);
+		if(area != NULL)
+		{
+			merge_area(area, single_area(g, pos));
+		}
+		else if(!put_area(set, root, single_area(g, pos)))
+		{
+			drop_area_sets(g);
+			return false;
+		}
 	}
+	return true;
 }
 
-/** @brief Uaktualnia liczbę wolnych pól dla graczy, których
- * pola sąsiadują polem o podanych współrzędnych, zajmowanym w wyniku
- * wykonania złotego ruchu.
- * @param[in] g 			– wskaźnik na strukturę gry
- * @param[in] x 			– numer kolumny, w której znajduje się
- * 							  dane pole
- * @param[in] y 			– numer wiersza, w którym znajduje się
- *							  dane pole
- */
-static void update_neighbours_touching_fields(gamma_t * g, uint32_t x, 
-														uint32_t y)
+bool gamma_area_begin(gamma_t * g, uint32_t player, gamma_area_iterator_t * it)
 {
-	uint32_t temp_array[4] = {0};
-	uint32_t temp_size = 0;
-	if(x > 0 && check_coordinates(g, x - 1, y) && !is_field_free(g, x - 1, y))
+	if(g == NULL || it == NULL || !is_player_in_range(g, player))
 	{
-		uint32_t at_left = (g->game_array)[convert_pos(g, x - 1, y)];
-		update_temp_neighbour_array(temp_array, &temp_size, at_left);
+		return false;
+	}
+	if(g->area_sets == NULL && !g->engine->build_area_sets(g))
+	{
+		return false;
 	}
-	if((x < g->width - 1) && check_coordinates(g, x + 1, y) 
-							&& !is_field_free(g, x + 1, y))
+	*it = (gamma_area_iterator_t) {g, player, 0};
+	return true;
+}
+
+bool gamma_area_next(gamma_area_iterator_t * it, gamma_area_t * area)
+{
+	if(it == NULL || area == NULL || it->g == NULL
+		|| it->g->area_sets == NULL)
 	{
-		uint32_t at_right = (g->game_array)[convert_pos(g, x + 1, y)];
-		update_temp_neighbour_array(temp_array, &temp_size, at_right);
+		return false;
 	}
-	if(y > 0 && check_coordinates(g, x, y - 1) && !is_field_free(g, x, y - 1))
+	const area_set * set = &(it->g->area_sets)[player_index(it->g, it->player)];
+	if(it->index >= set->roots.size)
 	{
-		uint32_t at_lower = (g->game_array)[convert_pos(g, x, y - 1)];
-		update_temp_neighbour_array(temp_array, &temp_size, at_lower);
+		return false;
 	}
-	if((y < g->height - 1) && check_coordinates(g, x, y + 1) 
-							&& !is_field_free(g, x, y + 1))
+	area_record record = (set->records)[it->index++];
+	*area = (gamma_area_t) {record.size, record.min_x, record.min_y,
+											record.max_x, record.max_y};
+	return true;
+}
+
+/** @brief Dopisuje do opisu skutków ruchu zmianę liczników gracza,
+ * sumując ją ze zmianą zapisaną wcześniej dla tego samego gracza.
+ * @param[in,out] effect – wskaźnik na opis skutków ruchu
+ * @param[in] player 	– numer gracza
+ * @param[in] areas 	– zmiana liczby obszarów gracza
+ * @param[in] busy 		– zmiana liczby pól zajętych przez gracza
+ * @param[in] free 		– zmiana liczby wolnych pól przyległych do pól gracza
+ */
+static void add_effect(gamma_effect_t * effect, uint32_t player,
+								int64_t areas, int64_t busy, int64_t free)
+{
+	uint32_t i = 0;
+	while(i < effect->count && (effect->players)[i].player != player)
 	{
-		uint32_t at_upper = (g->game_array)[convert_pos(g, x, y + 1)];
-		update_temp_neighbour_array(temp_array, &temp_size, at_upper);
+		i++;
 	}
-	for(uint32_t i = 0; i < temp_size; i++)
+	if(i == effect->count)
 	{
-		update_neighbours_array(g, temp_array[i], false);
+		(effect->players)[i] = (gamma_player_effect_t) {player, 0, 0, 0};
+		effect->count++;
 	}
+	(effect->players)[i].areas += areas;
+	(effect->players)[i].busy += busy;
+	(effect->players)[i].free += free;
 }
 
-/** @brief Uaktualnia liczby wolnych sąsiednich pól graczy po wykonaniu
- * ruchu (zarówno zwykłego, jak i złotego) na pole o danych współrzędnych.
+/** @brief Wyznacza skutki zwykłego ruchu gracza na pole o podanym numerze,
+ * nie modyfikując stanu gry.
  * @param[in] g 		– wskaźnik na strukturę gry
- * @param[in] player 	– numer gracza, dla którego aktualizujemy
- * 						  liczbę wolnych sąsiednich pól
- * @param[in] x			– numer kolumny, w której znajduje się dane pole
- * @param[in] y 		– numer wiersza, w którym znajduje się dane pole
- * @param[in] increase 	– czy zwiększamy liczbę wolnych sąsiednich pól,
- * 						  wartość @p true jeśli tak, a @p false w 
- * 						  przeciwnym wypadku
- * @param[in] golden 	– czy aktualizacja dotyczy złotego ruchu, wartość
- * 						  @p true jeśli tak, a @p false w przeciwnym wypadku
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– poprawny numer gracza
+ * @param[in] pos 		– numer pola na planszy
+ * @param[out] effect 	– wskaźnik na opis skutków ruchu
+ * @return Wartość @p true, gdy ruch jest legalny, a @p false w przeciwnym
+ * wypadku lub gdy nie udało się zaalokować pamięci.
  */
-static void update_neighbours(gamma_t * g, uint32_t player,
-							uint32_t x, uint32_t y, bool increase, bool golden)
+TOPOLOGY_KERNEL bool move_effect(gamma_t * g, const topology * t,
+						uint32_t player, uint64_t pos, gamma_effect_t * effect)
 {
-	if(x > 0 && is_new_free_neighbour(g, player, x - 1, y))
+	if(!is_field_free(g, pos))
 	{
-		update_neighbours_array(g, player, increase);
+		return false;
 	}
-	if((x < g->width - 1) && is_new_free_neighbour(g, player, x + 1, y))
+	neighbourhood n;
+	gather_neighbourhood(g, t, pos, &n);
+	if(is_isolated_in(t, &n, player) && !can_have_more_areas(g, player))
 	{
-		update_neighbours_array(g, player, increase);
+		return false;
 	}
-	if(y > 0 && is_new_free_neighbour(g, player, x, y - 1))
+	uint32_t areas = count_areas_around(g, t, player, pos, &n);
+	if(areas == UINT32_MAX)
 	{
-		update_neighbours_array(g, player, increase);
+		return false;
 	}
-	if((y < g->height - 1) && is_new_free_neighbour(g, player, x, y + 1))
+	effect->count = 0;
+	add_effect(effect, player, 1 - (int64_t) areas,
+				1, count_new_free_neighbours(g, t, player, pos, &n, NULL));
+	uint32_t touching[NEIGHBOURS];
+	uint32_t touching_size = 0;
+	UNROLL_NEIGHBOURS
+	for(uint32_t i = 0; i < t->neighbours; i++)
 	{
-		update_neighbours_array(g, player, increase);
+		if(is_player_in_range(g, n.owner[i]))
+		{
+			update_temp_neighbour_array(touching, &touching_size, n.owner[i]);
+		}
 	}
-	if(!golden)
+	for(uint32_t i = 0; i < touching_size; i++)
 	{
-		update_neighbours_touching_fields(g, x, y);
+		add_effect(effect, touching[i], 0, 0, -1);
 	}
+	return true;
 }
 
-/** @brief Wypełnia tablicę pomocniczą. Funkcja pomocnicza, wywoływana przez
- * funkcję @ref player_areas_around.
- * @param[in] g 				– wskaźnik na strukturę gry
- * @param[in] player 			– numer gracza, scharakteryzowany w opisie funkcji
- * 								  @ref player_areas_around
- * @param[in] x 				– numer kolumny, w której znajduje się pole opisane
- * 								  w opisie funkcji @ref player_areas_around
- * @param[in] y 				– numer wiersza, w którym znajduje się pole opisane
- * 								  w opisie funkcji @ref player_areas_around
- * @param[in] array[] 			– wypełniana tablica
- * @param[in] *array_size 		– wskaźnik na rozmiar wypełnianej tablicy
+bool gamma_move_effect(gamma_t * g, uint32_t player, uint32_t x, uint32_t y,
+												gamma_effect_t * effect)
+{
+	if(g == NULL || effect == NULL || !is_player_in_range(g, player)
+										|| !check_coordinates(g, x, y))
+	{
+		return false;
+	}
+	return g->engine->move_effect(g, player, convert_pos(g, x, y), effect);
+}
+
+/** @brief Wyznacza skutki złotego ruchu gracza na pole o podanym numerze,
+ * nie modyfikując stanu gry.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] t 		– kształt sąsiedztwa pól
+ * @param[in] player 	– poprawny numer gracza, który nie wykonał jeszcze
+ *						  złotego ruchu
+ * @param[in] pos 		– numer pola na planszy
+ * @param[out] effect 	– wskaźnik na opis skutków ruchu
+ * @return Wartość @p true, gdy ruch jest legalny, a @p false w przeciwnym
+ * wypadku lub gdy nie udało się zaalokować pamięci.
  */
-static void set_temp_fields_array(gamma_t * g, uint32_t player, uint32_t x,
-	uint32_t y, uint64_t array[], uint32_t * array_size)
+TOPOLOGY_KERNEL bool golden_effect(gamma_t * g, const topology * t,
+						uint32_t player, uint64_t pos, gamma_effect_t * effect)
 {
-	if(x > 0 && is_on_field(g, x - 1, y, player))
+	uint64_t victim = get_cell(g, pos);
+	if(victim == 0 || victim == player)
 	{
-		array[*array_size] = convert_pos(g, x - 1, y);
-		(*array_size)++;
+		return false;
 	}
-	if((x < g->width -1) && is_on_field(g, x + 1, y, player))
+	neighbourhood n;
+	gather_neighbourhood(g, t, pos, &n);
+	if(is_isolated_in(t, &n, player) && !can_have_more_areas(g, player))
 	{
-		array[*array_size] = convert_pos(g, x + 1, y);
-		(*array_size)++;
+		return false;
 	}
-	if((y < g->height - 1) && is_on_field(g, x, y + 1, player))
+	uint32_t split = count_victim_split(g, t, victim, pos);
+	if(split == UINT32_MAX || !is_split_allowed(g, victim, split))
 	{
-		array[*array_size] = convert_pos(g, x, y + 1);
-		(*array_size)++;
+		return false;
 	}
-	if(y > 0 && is_on_field(g, x, y - 1, player))
+	uint32_t areas = count_areas_around(g, t, player, pos, &n);
+	if(areas == UINT32_MAX)
 	{
-		array[*array_size] = convert_pos(g, x, y - 1);
-		(*array_size)++;
+		return false;
 	}
+	effect->count = 0;
+	add_effect(effect, player, 1 - (int64_t) areas,
+				1, count_new_free_neighbours(g, t, player, pos, &n, NULL));
+	add_effect(effect, victim, (int64_t) split - 1, -1,
+			-(int64_t) count_new_free_neighbours(g, t, victim, pos, &n, NULL));
+	return true;
 }
 
-/** @brief Zlicza ile różnych elementów znajduje się w tablicy
- * @p array. Funkcja pomocnicza, wywoływana przez funkcję
- * liczącą @ref player_areas_around
- * @param[in] g 			– wskaźnik na strukturę gry
- * @param[in] array[] 		– wskaźnik na pierwszy element tablicy
- * @param[in] array_size 	– rozmiar tablicy
- * @return Liczba różnych elementów w tablicy array
+bool gamma_golden_effect(gamma_t * g, uint32_t player, uint32_t x, uint32_t y,
+												gamma_effect_t * effect)
+{
+	if(g == NULL || effect == NULL || !is_player_in_range(g, player)
+		|| !check_coordinates(g, x, y)
+		|| (g->golden_used)[player_index(g, player)])
+	{
+		return false;
+	}
+	return g->engine->golden_effect(g, player, convert_pos(g, x, y), effect);
+}
+
+/** Makro definiujące silnik gry @p name##_engine dla kształtu sąsiedztwa
+	pól opisanego stałą @p name##_topology; funkcje oznaczone
+	@ref TOPOLOGY_KERNEL są wstawiane w funkcje silnika z tą stałą */
+#define DEFINE_ENGINE(name)												\
+static bool name##_move(gamma_t * g, uint32_t player,					\
+									uint64_t pos)						\
+{																		\
+	return exec_move(g, &name##_topology, player, pos);					\
+}																		\
+																		\
+static bool name##_golden_move(gamma_t * g, uint32_t player,			\
+									uint64_t pos)						\
+{																		\
+	return exec_golden(g, &name##_topology, player, pos);				\
+}																		\
+																		\
+static size_t name##_batch(gamma_t * g,									\
+		const gamma_move_t * moves, size_t n, bool * results, bool golden)	\
+{																		\
+	return exec_batch(g, &name##_topology, moves, n, results, golden);	\
+}																		\
+																		\
+static bool name##_border_target_found(gamma_t * g,						\
+									uint32_t player)					\
+{																		\
+	return is_border_target_found(g, &name##_topology, player);			\
+}																		\
+																		\
+static uint64_t name##_targets(gamma_t * g, uint32_t player,			\
+		gamma_field_t * targets, uint64_t size, bool first_only)		\
+{																		\
+	return iterate_board(g, &name##_topology, player, targets, size,	\
+									first_only);						\
+}																		\
+																		\
+static bool name##_build_adjacent_sets(gamma_t * g)						\
+{																		\
+	return build_adjacent_sets(g, &name##_topology);					\
+}																		\
+																		\
+static bool name##_build_area_sets(gamma_t * g)							\
+{																		\
+	return build_area_sets(g, &name##_topology);						\
+}																		\
+																		\
+static void name##_refresh_stale_areas(gamma_t * g)						\
+{																		\
+	refresh_stale_areas(g, &name##_topology);							\
+}																		\
+																		\
+static bool name##_undo(gamma_t * g)									\
+{																		\
+	return undo_records(g, &name##_topology);							\
+}																		\
+																		\
+static bool name##_move_effect(gamma_t * g, uint32_t player,			\
+		uint64_t pos, gamma_effect_t * effect)							\
+{																		\
+	return move_effect(g, &name##_topology, player, pos, effect);		\
+}																		\
+																		\
+static bool name##_golden_effect(gamma_t * g, uint32_t player,			\
+		uint64_t pos, gamma_effect_t * effect)							\
+{																		\
+	return golden_effect(g, &name##_topology, player, pos, effect);		\
+}																		\
+																		\
+static const engine name##_engine =										\
+{																		\
+	name##_move,														\
+	name##_golden_move,													\
+	name##_batch,														\
+	name##_border_target_found,											\
+	name##_targets,														\
+	name##_build_adjacent_sets,											\
+	name##_build_area_sets,												\
+	name##_refresh_stale_areas,											\
+	name##_undo,														\
+	name##_move_effect,													\
+	name##_golden_effect												\
+};
+
+DEFINE_ENGINE(square)
+DEFINE_ENGINE(hex)
+DEFINE_ENGINE(square8)
+
+/** @brief Wybiera silnik gry dla kształtu sąsiedztwa pól planszy.
+ * @param[in] topology 	– kształt sąsiedztwa pól
+ * @return Wskaźnik na silnik gry lub NULL, gdy kształt sąsiedztwa jest
+ * nieznany.
  */
-static uint32_t count_areas(gamma_t * g, uint64_t array[], uint32_t array_size)
+static const engine * select_engine(gamma_topology_t topology)
 {
-	uint32_t count_of_areas = 0;
-	for(uint32_t i = 0; i < array_size; i++)
+	switch(topology)
 	{
-		bool different = true;
-		for(uint32_t j = 0; j < i && different; j++)
+		case GAMMA_TOPOLOGY_SQUARE:
 		{
-			if(find_field(g, array[i]) == find_field(g, array[j]))
-			{
-				different = false;
-			}
+			return &square_engine;
 		}
-		if(different)
+		case GAMMA_TOPOLOGY_HEX:
 		{
-			count_of_areas++;
+			return &hex_engine;
 		}
-	}	
-	return count_of_areas;
-}
-
-/** @brief Liczy z iloma różnymi polami należącymi do gracza o numerze
- * @p player_id sąsiaduje pole o podanych współrzędnych.
- * @param[in] g 			– wskaźnik na strukturę gry
- * @param[in] player_id 	– numer gracza, którego ewentualne obszary 
- *							  przyległe do wskazanego pola chcemy sprawdzić
- * @param[in] x 			– numer kolumny, w której znajduje się wskazane pole
- * @param[in] y 			– numer wiersza, w którym znajduje się wskazane pole
- * @return Liczba różnych obszarów należących do gracza @p player_id, do
- * których przyległe jest pole o współrzędnych (@p x, @p y)
- */
-static uint32_t player_areas_around(gamma_t * g, uint32_t player_id,
-								 uint32_t x, uint32_t y)
-{
-	uint64_t temp_array[4];
-	uint32_t array_size = 0;
-	set_temp_fields_array(g, player_id, x, y, temp_array, &array_size);
-	uint32_t p_areas_around = count_areas(g, temp_array, array_size);
-	return p_areas_around;
+		case GAMMA_TOPOLOGY_SQUARE8:
+		{
+			return &square8_engine;
+		}
+		default:
+		{
+			return NULL;
+		}
+	}
 }
 
-/** @brief Aktualizuje parametry gracza oraz pola po wykonaniu zwykłego ruchu.
- * @param[in] g 			– wskaźnik na strukturę gry
- * @param[in] executor      – numer gracza wykonującego ruch
- * @param[in] x 			– numer kolumny, w której znajduje się pole, które
- * 							  zajął w ruchu gracz @p move_executor
- * @param[in] y 			– numer wiersza, w którym znajduje się pole, które
- * 							  zajął w ruchu gracz @p move_executor
- */
-static inline void update_after_move(gamma_t * g, uint32_t executor,
-				uint32_t x, uint32_t y)
+gamma_t * gamma_new(uint32_t width, uint32_t height,
+                   uint32_t players, uint32_t areas)
 {
-	uint64_t current = convert_pos(g, x, y);
-
-	update_neighbours(g, executor, x, y, true, false);
-	(g->game_array)[current] = executor;
-
-	g->busy_fields_count++;
-
-    (g->occupied_fields_array)[executor-1]++;
-    (g->areas_array)[executor-1]++;
-    (g->areas_array)[executor-1] -= player_areas_around(g, executor, x, y);
-
-	union_field(g, x, y);
+	return gamma_new_ex(width, height, players, areas, NULL);
 }
 
-bool gamma_move(gamma_t * g, uint32_t player, uint32_t x, uint32_t y)
+gamma_t * gamma_new_ex(uint32_t width, uint32_t height, uint32_t players,
+						uint32_t areas, const gamma_options_t * options)
 {
-	if(g != NULL && is_player_in_range(g, player)
-		 && check_coordinates(g, x, y) && is_field_free(g, x, y))
+	if(wrong_params(width, height, players, areas))
 	{
-		bool check_areas = can_have_more_areas(g, player);
-		bool isolated = is_field_isolated(g, player, x, y);
-		if((check_areas && isolated) || !isolated)
-		{
-			update_after_move(g, player, x, y);
-			return true;
-		}
-		else
-		{
-			return false;
-		}
+		return NULL;
+	}
+	bool borrowed = (options != NULL && options->storage != NULL);
+	gamma_t params;
+	set_basic_gamma_params(&params, width, height, players, areas);
+	if(options != NULL)
+	{
+		params.topology = options->topology;
 	}
-	else
+	params.engine = select_engine(params.topology);
+	if(params.engine == NULL)
 	{
-		return false;
+		return NULL;
 	}
-}
-
-uint64_t gamma_busy_fields(gamma_t * g, uint32_t player)
-{
-	if(g != NULL && is_player_in_range(g, player))
+	set_layout(&params);
+	set_element_sizes(&params);
+	if(params.stride > UINT64_MAX / ((uint64_t) height + 2))
 	{
-        return (g->occupied_fields_array)[player-1];
+		return NULL;
 	}
-	else
+	if(borrowed && (players >= SPARSE_MIN_PLAYERS
+			|| params.stride > SPARSE_MIN_FIELDS / ((uint64_t) height + 2)))
 	{
-		return 0;
+		return NULL;
 	}
-}
-                                                                           
-uint64_t gamma_free_fields(gamma_t * g, uint32_t player)
-{
-	if(g != NULL && is_player_in_range(g, player))
+	if(players >= SPARSE_MIN_PLAYERS)
 	{
-		if(can_have_more_areas(g, player))
-		{
-			uint64_t b_size = (uint64_t) g->width * (uint64_t) g->height;
-			return (b_size - g->busy_fields_count);
-		}
-		else
+		params.player_table = calloc(2 * PLAYERS_INITIAL_CAPACITY,
+											sizeof(player_slot));
+		if(params.player_table == NULL)
 		{
-			return (g->free_neighbours)[player-1];
+			return NULL;
 		}
+		params.players_capacity = PLAYERS_INITIAL_CAPACITY;
 	}
-	else
+	gamma_t * new_gamma = NULL;
+	if(params.stride <= SPARSE_MIN_FIELDS / ((uint64_t) height + 2))
 	{
-		return 0;
+		new_gamma = allocate_game(&params, options);
 	}
-}
-
-/** @brief Aktualizuje powiązania między polami należącymi do
- * tego samego spójnego obszaru na planszy.
- * @param[in] g 			– wskaźnik na strukturę gry
- */
-static void update_board_golden(gamma_t * g)
-{
-	if(g != NULL)
+	if(new_gamma == NULL && borrowed)
 	{
-		uint64_t board_size = (uint64_t) g->width * (uint64_t) g->height;
-		uint64_t * first_array = g->parent_array;
-		uint64_t * second_array = g->rank_array;
-		for(uint64_t i = 0; i < board_size; i++)
+		return NULL;
+	}
+	if(new_gamma == NULL)
+	{
+		params.stride = (uint64_t) width + 2;
+		params.stride_shift = 0;
+		params.sparse_entries = calloc(SPARSE_INITIAL_CAPACITY,
+											sizeof(sparse_entry));
+		params.sparse_capacity = SPARSE_INITIAL_CAPACITY;
+		if(params.sparse_entries != NULL)
 		{
-			first_array[i] = i;
-			second_array[i] = 0;
+			new_gamma = allocate_game(&params, options);
 		}
-		for(uint32_t x = 0; x < g->width; x++)
+		if(new_gamma == NULL)
 		{
-			for(uint32_t y = 0; y < g->height; y++)
-			{
-				union_field(g, x, y);
-			}
+			free(params.sparse_entries);
+			free(params.player_table);
+			return NULL;
 		}
 	}
-}
-
-/** @brief Aktualizuje parametry gracza po złotym ruchu.
- * Wywoływana na rzecz zarówno gracza wykonującego ten ruch, jak i
- * gracza, którego pionek zostaje zabrany z planszy gry.
- * @param[in] g 				– 	wskaźnik na strukturę gry
- * @param[in] player 			– 	numer gracza, którego parametry aktualizujemy
- * @param[in] x 				– 	numer kolumny, w której znajduje się pole, 
- *							  		na które wykonany został złoty ruch
- * @param[in] y 				– 	numer wiersza, w którym znajduje się pole, 
- *							  		na które wykonany został złoty ruch
- * @param[in] is_move_executor 	– 	czy aktualizujemy parametry gracza
- * 									wykonującego złoty ruch, wartość @p true, 
- *									gdy aktualizacja parametrów dotyczy gracza 
- *									wykonującego ruch, a @p false, gdy
- * 									aktualizujemy parametry gracza, którego
- *								 	pionek został zabrany z planszy.
- */
-static inline void update_player_golden(gamma_t * g, uint32_t player,
- 				 uint32_t x, uint32_t y, bool is_move_executor)
-{
-	uint32_t areas = player_areas_around(g, player, x, y);
-	if(is_move_executor)
-	{
-        (g->areas_array)[player-1]++;
-        (g->areas_array)[player-1] -= areas;
-        (g->occupied_fields_array)[player-1]++;
-        (g->golden_moves_array)[player-1] = false;
-        update_neighbours(g, player, x, y, true, true);
-	}
-	else
+	if(!allocate_players(new_gamma))
 	{
-        (g->areas_array)[player-1] += areas;
-        (g->areas_array)[player-1]--;
-        (g->occupied_fields_array)[player-1]--;
-        update_neighbours(g, player, x, y, false, true);
+		gamma_delete(new_gamma);
+		return NULL;
 	}
+	set_frame(new_gamma);
+	return new_gamma;
 }
 
-/** @brief Sprawdza, czy w wyniku wykonania złotego ruchu
- * ani gracz wykonujący ten ruch, ani gracz, którego pionek jest
- * zdejmowany z planszy, nie wejdzie w posiadanie zbyt dużej liczby
- * obszarów przekraczającej tę dopuszczalną ustaloną w strukturze
- * @p g gry.
- * @param[in] g 		– wskaźnik na strukturę gry
- * @param[in] executor  – numer gracza wykonującego złoty ruch
- * @param[in] victim 	– numer gracza, którego pole zostaje zajęte
- * 						  przez gracza wykonującego złoty ruch
- * @param[in] x 		– numer kolumny, w której znajduje się pole,
- *						  na które wykonywany jest złoty ruch
- * @param[in] y 		– numer kolumny, w której znajduje się pole, 
- *						  na które wykonywany jest złoty ruch
- * @return Wartość @p true, gdy ruch jest legalny i żaden z graczy
- * nie będzie posiadał zbyt wielu obszarów, a @p false, gdy ruch
- * nie jest legalny, bo któryś z graczy przekroczy dozwoloną
- * liczbę obszarów
+/** @struct gamma_snapshot
+ * Zapamiętany stan gry, przechowywany w jednym ciągłym bloku pamięci
  */
-static bool area_check_golden(gamma_t * g, uint32_t executor,
-		uint32_t victim, uint32_t x, uint32_t y)
+struct gamma_snapshot
 {
-	uint32_t area_limit = g->maximum_area_count;
-
-
-	uint32_t exec_around = player_areas_around(g, executor, x, y);
-	uint32_t vic_around = player_areas_around(g, victim, x, y);
-
-	uint32_t exec_areas = (g->areas_array)[executor-1] + 1 - exec_around;
-	uint32_t vic_areas = (g->areas_array)[victim-1] + vic_around - 1;
+	uint32_t width;
+	/**< Szerokość planszy gry, z której pochodzi stan */
+	uint32_t height;
+	/**< Wysokość planszy gry, z której pochodzi stan */
+	uint32_t players_count;
+	/**< Liczba graczy w grze, z której pochodzi stan */
+	uint32_t maximum_area_count;
+	/**< Maksymalna liczba obszarów gracza w grze, z której pochodzi stan */
+	gamma_topology_t topology;
+	/**< Kształt sąsiedztwa pól w grze, z której pochodzi stan */
+	uint64_t busy_fields_count;
+	/**< Liczba zajętych pól na planszy */
+	uint64_t hash;
+	/**< Skrót Zobrista stanu gry */
+	uint64_t sparse_capacity;
+	/**< Rozmiar tablicy pól w trybie rzadkim lub 0 w trybie gęstym */
+	uint64_t sparse_size;
+	/**< Liczba pól w tablicy pól w trybie rzadkim */
+	uint64_t players_capacity;
+	/**< Wymiar tablic graczy w trybie rzadkim graczy lub 0 w trybie gęstym
+	graczy */
+	uint32_t players_active;
+	/**< Liczba graczy, którzy wykonali ruch, w trybie rzadkim graczy */
+	uint64_t size;
+	/**< Rozmiar w bajtach tablicy @p data */
+	unsigned char data[];
+	/**< Kolejne tablice stanu gry wyznaczone przez @ref state_blocks */
+};
 
-	return (exec_areas <= area_limit && vic_areas <= area_limit);
-}
+/** Największa liczba tablic składających się na stan gry */
+#define STATE_BLOCKS_MAX 8
 
-/** @brief Funkcja wykrywająca przypadek, gdy gracz chce zająć w złotym ruchu
- * pionek odizolowany od obszarów przez siebie posiadanych, gdy nie ma
- * możliwości zajęcia kolejnego obszaru. W szczególnych przypadkach
- * znacznie skraca czas wykonania funkcji exec_golden
- * (gdy ruch nie może zostać wykonany z opisanego powodu).
+/** @brief Wyznacza tablice składające się na stan gry wraz z ich
+ * rozmiarami. Tablice pomocnicze (stos @p area_stack, pamięć odpowiedzi
+ * funkcji @ref gamma_golden_possible) nie należą do stanu gry.
  * @param[in] g 		– wskaźnik na strukturę gry
- * @param[in] executor  – numer gracza chcącego wykonać
- *						  złoty ruch
- * @param[in] x   		– numer kolumny, w której znajduje się pole,
- *						  które chce przejąć gracz @p executor
- * @param[in] y 		– numer wiersza, w którym znajduje się pole,
- *						  które chce przejąć gracz @p executor
- * @return Wartość @p true, gdy nie zachodzi opisany warunek
- * uniemożliwiający wykonanie złotego ruchu, a wartość @p false,
- * gdy zachodzi i wówczas złoty ruch jest niemożliwy.
+ * @param[out] blocks 	– tablica wskaźników na tablice stanu gry
+ * @param[out] sizes 	– tablica rozmiarów w bajtach tablic stanu gry
+ * @return Liczba tablic stanu gry.
  */
-static bool initial_golden_check(gamma_t * g, uint32_t executor,
-									uint32_t x, uint32_t y)
+static uint32_t state_blocks(gamma_t * g, void * blocks[], uint64_t sizes[])
 {
-	if(is_field_isolated(g, executor, x, y) && !can_have_more_areas(g, executor))
+	uint64_t a_size = storage_size(g);
+	uint64_t players = player_slots(g);
+	uint32_t count = 0;
+	if(g->sparse_entries != NULL)
 	{
-		return false;
+		blocks[count] = g->sparse_entries;
+		sizes[count++] = g->sparse_capacity * sizeof(sparse_entry);
 	}
 	else
 	{
-		return true;
+		blocks[count] = g->game_array;
+		sizes[count++] = a_size * g->cell_bytes;
+		blocks[count] = g->parent_array;
+		sizes[count++] = a_size * g->parent_bytes;
+		blocks[count] = g->rank_array;
+		sizes[count++] = a_size * sizeof(uint8_t);
+	}
+	blocks[count] = g->areas_array;
+	sizes[count++] = players * sizeof(uint32_t);
+	blocks[count] = g->occupied_fields_array;
+	sizes[count++] = players * sizeof(uint64_t);
+	blocks[count] = g->free_neighbours;
+	sizes[count++] = players * sizeof(uint64_t);
+	blocks[count] = g->golden_used;
+	sizes[count++] = players * sizeof(bool);
+	if(g->player_table != NULL)
+	{
+		blocks[count] = g->player_table;
+		sizes[count++] = 2 * players * sizeof(player_slot);
+	}
+	if(g->bitboards != NULL)
+	{
+		blocks[count] = g->bitboards;
+		sizes[count++] = (players + 1) * g->height * sizeof(uint64_t);
 	}
+	return count;
 }
 
-/** @brief Odpowiada za wykonanie złotego ruchu, uprzednio
- * sprawdzając, czy jest legalny względem zarówno gracza
- * @p executor, jak i gracza, którego pole chce zająć
- * gracz @p executor.
- * @param[in] g 		– wskaźnik na strukturę gry
- * @param[in] executor 	– numer gracza wykonującego złoty ruch
- * @param[in] x 		– numer kolumny, w której znajduje się pole,
- * 						  na które gracz @p executor chce wykonać 
- *						  złoty ruch
- * @param[in] y 		– numer wiersza, w którym znajduje się pole,
- * 						  na które gracz @p executor chce wykonać
- *						  złoty ruch.
- * @return Wartość @p true, gdy ruch jest legalny; jednocześnie jest on
- * wykonany w ciele funkcji, a wartość @p false, gdy ruch nie jest legalny i
- * wówczas nic się nie dzieje
- */
-static bool exec_golden(gamma_t * g, uint32_t executor,
-								 uint32_t x, uint32_t y)
+gamma_snapshot_t * gamma_snapshot(gamma_t * g)
 {
-	if(g != NULL && !is_field_free(g, x, y)
-				&& !is_on_field(g, x, y, executor))
+	if(g == NULL)
 	{
-		uint64_t pos = convert_pos(g, x, y);
-		uint32_t victim = (g->game_array)[pos];
-		bool quick_check_executor = initial_golden_check(g, executor, x, y);
-		if(!quick_check_executor)
-		{
-			return false;
-		}
-		(g->game_array)[pos] = 0;
-		update_board_golden(g);
-		if(area_check_golden(g, executor, victim, x, y))
-		{
-			update_player_golden(g, executor, x, y, true);
-			update_player_golden(g, victim, x, y, false);
-			(g->game_array)[pos] = executor;
-			union_field(g, x, y);
-			return true;
-		}
-		else
-		{
-			(g->game_array)[pos] = victim;
-			union_field(g, x, y);
-			return false;
-		}
+		return NULL;
 	}
-	else
+	g->engine->refresh_stale_areas(g);
+	void * blocks[STATE_BLOCKS_MAX];
+	uint64_t sizes[STATE_BLOCKS_MAX];
+	uint32_t count = state_blocks(g, blocks, sizes);
+	uint64_t total = 0;
+	for(uint32_t i = 0; i < count; i++)
 	{
-		return false;
+		total += sizes[i];
+	}
+	gamma_snapshot_t * snapshot = malloc(sizeof(gamma_snapshot_t) + total);
+	if(snapshot == NULL)
+	{
+		return NULL;
+	}
+	snapshot->width = g->width;
+	snapshot->height = g->height;
+	snapshot->players_count = g->players_count;
+	snapshot->maximum_area_count = g->maximum_area_count;
+	snapshot->topology = g->topology;
+	snapshot->busy_fields_count = g->busy_fields_count;
+	snapshot->hash = g->hash;
+	snapshot->sparse_capacity = g->sparse_capacity;
+	snapshot->sparse_size = g->sparse_size;
+	snapshot->players_capacity = g->players_capacity;
+	snapshot->players_active = g->players_active;
+	snapshot->size = total;
+	unsigned char * data = snapshot->data;
+	for(uint32_t i = 0; i < count; i++)
+	{
+		memcpy(data, blocks[i], sizes[i]);
+		data += sizes[i];
 	}
+	return snapshot;
 }
 
-bool gamma_golden_move(gamma_t * g, uint32_t player, uint32_t x, uint32_t y)
+/** @brief Zmienia wymiar tablic graczy w trybie rzadkim graczy na wymiar
+ * tablic zapamiętanego stanu, którego zawartość zostanie do nich
+ * skopiowana. Usuwa przy tym zbiory wolnych pól przyległych do pól graczy,
+ * zbiory obszarów graczy i zbiory pól innych graczy przyległych do ich pól.
+ * @param[in,out] g 		– wskaźnik na strukturę gry
+ * @param[in] capacity 		– wymiar tablic graczy zapamiętanego stanu
+ * @return Wartość @p false, gdy nie udało się zaalokować pamięci,
+ * a @p true w przeciwnym wypadku.
+ */
+static bool resize_players_for(gamma_t * g, uint64_t capacity)
 {
-	if(g != NULL && is_player_in_range(g, player) && check_coordinates(g, x, y)
-											&& gamma_golden_possible(g, player))
-	{
-		return exec_golden(g, player, x, y);
-	}
-	else
+	drop_adjacent_sets(g);
+	drop_area_sets(g);
+	drop_border_sets(g);
+	player_slot * table = malloc(2 * capacity * sizeof(player_slot));
+	if(table == NULL || (!resize_player_arrays(g, capacity)
+							&& capacity > g->players_capacity))
 	{
+		free(table);
 		return false;
 	}
+	free(g->player_table);
+	g->player_table = table;
+	g->players_capacity = capacity;
+	return true;
 }
 
-/** @brief Sprawdza czy gracz @p player może wykonać złoty ruch
- * na pole o podanych współrzędnych.
- * @param[in] g - wskaźnik na strukturę gry
- * @param[in] x - numer kolumny, w której znajduje się
- * sprawdzane pole
- * @param[in] y - numer wiersza, w którym znajduje się
- * sprawdzane pole
- * @param[in] player - numer gracza, dla którego
- * sprawdzamy możliwość wykonania złotego ruchu na dane pole
- * @return Wartość @p true, gdy gracz @p player może wykonać
- * złoty ruch na dane pole, a @p false w przeciwnym wypadku.
- */
-static inline bool check_field_golden_possible(gamma_t * g, 
-					uint32_t x, uint32_t y, uint32_t player)
-{
-	uint64_t current_pos = convert_pos(g, x, y);
-	uint32_t player_at_field = (g->game_array)[current_pos];
-	(g->game_array)[current_pos] = player;
-	update_board_golden(g);
-	uint32_t areas_f = player_areas_around(g, player, x, y);
-	uint32_t areas_s = player_areas_around(g, player_at_field, x, y);
-	bool first = ((g->areas_array)[player-1] + 1 - areas_f
-					<= g->maximum_area_count);
-	bool second =((g->areas_array)[player_at_field-1] + areas_s - 1
-					<= g->maximum_area_count);
-	(g->game_array)[current_pos] = player_at_field;
-	update_board_golden(g);
-	return (first && second);
-}
-
-/** @brief Iteruje po polach zajętych przez graczy innych niż @p player,
- * dla każdego pola sprawdza, czy możliwe jest dla gracza wykonanie na nie
- * złotego ruchu.
- * @param[in] g - wskaźnik na strukturę gry
- * @param[in] player - numer gracza
- * @param[in] possible - wskaźnik na zmienną logiczną informującą,
- * czy gracz @p player może wykonać złoty ruch
- */
-static inline void iterate_board(gamma_t * g, uint32_t player, bool * possible)
+bool gamma_restore(gamma_t * g, const gamma_snapshot_t * snapshot)
 {
-	for(uint32_t i = 0; i < g->width && !(*possible); i++)
+	if(g == NULL || snapshot == NULL || snapshot->width != g->width
+		|| snapshot->height != g->height
+		|| snapshot->players_count != g->players_count
+		|| snapshot->maximum_area_count != g->maximum_area_count
+		|| snapshot->topology != g->topology
+		|| (snapshot->sparse_capacity == 0) != (g->sparse_entries == NULL))
+	{
+		return false;
+	}
+	if(g->sparse_capacity != snapshot->sparse_capacity)
 	{
-		for(uint32_t j = 0; j < g->height && !(*possible); j++)
+		sparse_entry * entries = malloc(snapshot->sparse_capacity
+												* sizeof(sparse_entry));
+		if(entries == NULL)
 		{
-			if(!(is_field_free(g, i, j) || is_on_field(g, i, j, player)
-								|| is_field_isolated(g, player, i, j)))
-			{
-				*possible = check_field_golden_possible(g, i, j, player);
-			}
+			return false;
 		}
+		free(g->sparse_entries);
+		g->sparse_entries = entries;
+		g->sparse_capacity = snapshot->sparse_capacity;
+	}
+	g->sparse_size = snapshot->sparse_size;
+	if(g->players_capacity != snapshot->players_capacity
+		&& !resize_players_for(g, snapshot->players_capacity))
+	{
+		return false;
+	}
+	g->players_active = snapshot->players_active;
+	void * blocks[STATE_BLOCKS_MAX];
+	uint64_t sizes[STATE_BLOCKS_MAX];
+	uint32_t count = state_blocks(g, blocks, sizes);
+	const unsigned char * data = snapshot->data;
+	for(uint32_t i = 0; i < count; i++)
+	{
+		memcpy(blocks[i], data, sizes[i]);
+		data += sizes[i];
 	}
+	g->busy_fields_count = snapshot->busy_fields_count;
+	g->hash = snapshot->hash;
+	g->touched_low = 0;
+	g->touched_high = UINT64_MAX;
+	g->board_version++;
+	g->undo_size = 0;
+	g->stale_size = 0;
+	drop_adjacent_sets(g);
+	drop_area_sets(g);
+	drop_border_sets(g);
+	return true;
 }
 
-bool gamma_golden_possible(gamma_t * g, uint32_t player)
+void gamma_snapshot_delete(gamma_snapshot_t * snapshot)
 {
-	if(g != NULL && is_player_in_range(g, player))
+	free(snapshot);
+}
+
+void gamma_undo_enable(gamma_t * g, bool enabled)
+{
+	if(g != NULL)
 	{
-        bool from_player = (g->golden_moves_array)[player-1];
-        if(!from_player)
-        {
-        	return false;
-        }
-		bool from_board = (g->busy_fields_count > (g->occupied_fields_array)[player-1]);
-		if(from_board && can_have_more_areas(g, player))
-		{
-			return true;
-		}
-		else if(from_board)
+		g->undo_enabled = enabled;
+		if(enabled)
 		{
-			bool possible = false;
-			iterate_board(g, player, &possible);
-			return possible;
+			g->engine->refresh_stale_areas(g);
 		}
 		else
 		{
-			return false;
+			free(g->undo_log);
+			g->undo_log = NULL;
+			g->undo_size = 0;
+			g->undo_capacity = 0;
 		}
 	}
-	else
+}
+
+bool gamma_undo(gamma_t * g)
+{
+	if(g == NULL || g->undo_size == 0)
 	{
 		return false;
 	}
+	drop_area_sets(g);
+	bool begun = write_begin(g);
+	bool undone = g->engine->undo(g);
+	write_end(g, begun);
+	return undone;
 }
 
-/** @brief Tworzy tablicę zawierającą stan gry,
- * gdy liczba graczy w grze nie przekracza 9.
- * @param[in] g 		– wskaźnik na strukturę gry
- * @return Wskaźnik na utworzoną tablicę znaków
- */	
-static char * board_less_than_ten(gamma_t * g)
+/** Makro definiujące funkcję wypisującą do napisu pola wiersza planszy
+	o elementach typu @p type, gdy liczba graczy nie przekracza 9 */
+#define DEFINE_FILL_ROW(type)											\
+static void fill_row_##type(type * row, char * line, uint64_t w)		\
+{																		\
+	for(uint64_t x = 0; x < w; x++)										\
+	{																	\
+		type player = LOAD_SHARED(row[x]);								\
+		line[x] = (player == 0) ? '.' : (char) (player + '0');			\
+	}																	\
+}
+
+DEFINE_FILL_ROW(uint8_t)
+DEFINE_FILL_ROW(uint16_t)
+DEFINE_FILL_ROW(uint32_t)
+
+/** @brief Wypisuje do napisu pola planszy w trybie rzadkim, gdy liczba
+ * graczy nie przekracza 9: wypełnia wiersze znakami wolnych pól, a następnie
+ * wpisuje numery graczy zajmujących pola tablicy @p sparse_entries.
+ * @param[in] g 		– wskaźnik na strukturę gry w trybie rzadkim
+ * @param[out] board 	– napis z ustawionymi znakami końca wiersza
+ */
+static void fill_sparse_board(gamma_t * g, char * board)
 {
-	uint64_t h = (uint64_t) g->height;
-	uint64_t w = (uint64_t) g->width;
-	uint64_t array_size = h * (w + 1) + 1;
-	char * board = malloc(array_size * sizeof(char));
-	if(board == NULL)
+	uint64_t w = g->width;
+	for(uint64_t y = 0; y < g->height; y++)
 	{
-		return NULL;
+		memset(board + y * (w + 1), '.', w);
 	}
-	board[array_size - 1] = '\0';
-	for(uint64_t i = w; i < array_size-1; i += (w + 1))
+	for(uint64_t i = 0; i < g->sparse_capacity; i++)
 	{
-		board[i] = '\n';
+		const sparse_entry * entry = &(g->sparse_entries)[i];
+		if(entry->pos != 0 && entry->player != 0)
+		{
+			uint64_t x = entry->pos % g->stride - 1;
+			uint64_t y = entry->pos / g->stride - 1;
+			board[(g->height - 1 - y) * (w + 1) + x] = (char) (entry->player + '0');
+		}
+	}
+}
+
+/** @brief Wypisuje do napisu pola wiersza planszy w trybie gęstym,
+ * gdy liczba graczy nie przekracza 9.
+ * @param[in] g 				– wskaźnik na strukturę gry w trybie gęstym
+ * @param[out] line 			– początek wiersza napisu
+ * @param[in] y 				– numer wiersza planszy
+ */
+static void fill_board_row(gamma_t * g, char * line, uint32_t y)
+{
+	if(g->stride_shift != 0)
+	{
+		for(uint32_t x = 0; x < g->width; x++)
+		{
+			uint64_t player = read_cell(g, convert_pos(g, x, y));
+			line[x] = (player == 0) ? '.' : (char) (player + '0');
+		}
+		return;
 	}
-	uint64_t i = h * w;
-	while(i > 0)
+	uint64_t first = convert_pos(g, 0, y);
+	switch(g->cell_bytes)
 	{
-		i--;
-		uint32_t field_p = (g->game_array)[i];
-		uint64_t y = i / w;
-		uint64_t x = i - y * w;
-		uint64_t new_index = (h-1-y)*(w+1) + x;
-		if(field_p == 0)
+		case sizeof(uint8_t):
 		{
-			board[new_index] = '.';
+			fill_row_uint8_t((uint8_t *) g->game_array + first, line, g->width);
+			break;
 		}
-		else
+		case sizeof(uint16_t):
+		{
+			fill_row_uint16_t((uint16_t *) g->game_array + first, line,
+																g->width);
+			break;
+		}
+		default:
 		{
-			board[new_index] = field_p + '0';
+			fill_row_uint32_t((uint32_t *) g->game_array + first, line,
+																g->width);
+			break;
 		}
 	}
-	return board;
 }
 
 /** @brief Zlicza ile cyfr w zapisie dziesiętnym
@@ -1137,9 +6163,100 @@ static inline void set_board_space(char * board, uint32_t player,
 	}
 }
 
+/** @brief Wypisuje do napisu pola wiersza planszy, gdy liczba graczy
+ * przekracza 9: numer każdego gracza zajmuje pole szerokości @p digits
+ * znaków, a pola oddzielone są spacjami.
+ * @param[in] g 				– wskaźnik na strukturę gry
+ * @param[out] line 			– początek wiersza napisu
+ * @param[in] y 				– numer wiersza planszy
+ * @param[in] digits 			– liczba cyfr największego numeru gracza
+ */
+static void fill_wide_row(gamma_t * g, char * line, uint32_t y,
+													uint64_t digits)
+{
+	for(uint32_t x = 0; x < g->width; x++)
+	{
+		uint64_t start = x * (digits + 1);
+		set_board_space(line, read_cell(g, convert_pos(g, x, y)),
+										start, start + digits - 1);
+		if(x + 1 < g->width)
+		{
+			line[start + digits] = ' ';
+		}
+	}
+}
+
+/** @brief Wypisuje do napisu wszystkie wiersze planszy w trybie gęstym.
+ * Każdy wiersz odczytywany jest pod ochroną jego licznika z tablicy
+ * @p row_sequences i powtarzany, gdy w trakcie odczytu zmieniło się
+ * któreś z jego pól; zmiany innych wierszy nie wymuszają ponownego
+ * odczytu, więc zmiany stanu gry wykonywane w trakcie odczytu opóźniają
+ * go co najwyżej o odczyt zmienionych wierszy.
+ * @param[in] g 				– wskaźnik na strukturę gry w trybie gęstym
+ * @param[out] board 			– napis z ustawionymi znakami końca wiersza
+ * @param[in] line_size 		– długość wiersza napisu wraz ze znakiem
+ *								  końca wiersza
+ * @param[in] digits 			– liczba cyfr największego numeru gracza,
+ *								  gdy przekracza on 9, a 0 w przeciwnym
+ *								  wypadku
+ */
+static void fill_board_rows(gamma_t * g, char * board, uint64_t line_size,
+															uint64_t digits)
+{
+	for(uint32_t y = 0; y < g->height; y++)
+	{
+		char * line = board + (uint64_t) (g->height - 1 - y) * line_size;
+		_Atomic uint64_t * counter = &(g->row_sequences)[(uint64_t) y + 1];
+		uint64_t sequence;
+		do
+		{
+			sequence = read_begin(counter);
+			if(digits == 0)
+			{
+				fill_board_row(g, line, y);
+			}
+			else
+			{
+				fill_wide_row(g, line, y, digits);
+			}
+		} while(read_retry(counter, sequence));
+	}
+}
+
+/** @brief Tworzy tablicę zawierającą stan gry,
+ * gdy liczba graczy w grze nie przekracza 9.
+ * @param[in] g 		– wskaźnik na strukturę gry
+ * @return Wskaźnik na utworzoną tablicę znaków
+ */	
+static char * board_less_than_ten(gamma_t * g)
+{
+	uint64_t h = (uint64_t) g->height;
+	uint64_t w = (uint64_t) g->width;
+	uint64_t array_size = h * (w + 1) + 1;
+	char * board = malloc(array_size * sizeof(char));
+	if(board == NULL)
+	{
+		return NULL;
+	}
+	board[array_size - 1] = '\0';
+	for(uint64_t i = w; i < array_size-1; i += (w + 1))
+	{
+		board[i] = '\n';
+	}
+	if(g->sparse_entries != NULL)
+	{
+		fill_sparse_board(g, board);
+	}
+	else
+	{
+		fill_board_rows(g, board, w + 1, 0);
+	}
+	return board;
+}
+
 /** @brief Tworzy tablicę zawierającą stan gry,
  * gdy liczba graczy w grze przekracza 9.
- * @param[in] g 		– wskaźnik na strukturę gry
+ * @param[in] g 		– wskaźnik na strukturę gry
  * @return Wskaźnik na utworzoną tablicę znaków
  */								
 static char * board_more_than_nine(gamma_t * g)
@@ -1165,31 +6282,33 @@ static char * board_more_than_nine(gamma_t * g)
 		board[i] = '\n';
 	}
 
-	for(uint64_t i = 0; i < b_h; i++)
+	if(g->sparse_entries != NULL)
 	{
-		for(uint64_t j = 0; j < b_w - 1; j = j+log+1)
-		{
-			uint32_t x = (uint32_t) j/(log+1);
-			uint64_t pos = i*b_w + j;
-			uint32_t field_p = (g->game_array)[convert_pos(g, x, g->height-1-i)];
-			set_board_space(board, field_p, pos, pos+log-1);
-		}
-		for(uint64_t j = 0; j < b_w-1; j++)
+		for(uint32_t y = 0; y < g->height; y++)
 		{
-			if((j+1)%(log+1) == 0)
-			{
-				board[i*b_w + j] = ' ';
-			}	
+			fill_wide_row(g, board + (b_h - 1 - y) * b_w, y, log);
 		}
 	}
+	else
+	{
+		fill_board_rows(g, board, b_w, log);
+	}
 	return board;
 }
 
+uint64_t gamma_hash(gamma_t * g)
+{
+	if(g == NULL)
+	{
+		return 0;
+	}
+	return g->hash;
+}
+
 char * gamma_board(gamma_t * g)
 {
 	if(g != NULL)
 	{
-
 		if(g->players_count <= 9)
 		{
 			return board_less_than_ten(g);
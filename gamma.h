@@ -11,6 +11,7 @@
 #define GAMMA_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -18,6 +19,164 @@
  */
 typedef struct gamma gamma_t;
 
+/**
+ * Struktura opisująca pole planszy.
+ */
+typedef struct gamma_field
+{
+  uint32_t x;
+  /**< Numer kolumny, w której znajduje się pole */
+  uint32_t y;
+  /**< Numer wiersza, w którym znajduje się pole */
+} gamma_field_t;
+
+/**
+ * Struktura opisująca ruch wykonywany w ramach wsadu.
+ */
+typedef struct gamma_batch_move
+{
+  uint32_t player;
+  /**< Numer gracza wykonującego ruch */
+  uint32_t x;
+  /**< Numer kolumny pola */
+  uint32_t y;
+  /**< Numer wiersza pola */
+} gamma_move_t;
+
+/**
+ * Struktura opisująca zmianę liczników gracza w wyniku ruchu.
+ */
+typedef struct gamma_player_effect
+{
+  uint32_t player;
+  /**< Numer gracza */
+  int64_t areas;
+  /**< Zmiana liczby obszarów zajętych przez gracza */
+  int64_t busy;
+  /**< Zmiana liczby pól zajętych przez gracza */
+  int64_t free;
+  /**< Zmiana liczby wolnych pól sąsiadujących z polami gracza */
+} gamma_player_effect_t;
+
+/**
+ * Największa liczba graczy, których liczniki może zmienić jeden ruch:
+ * gracz wykonujący ruch i gracze zajmujący sąsiadów pola na planszy,
+ * na której pola stykające się rogami są sąsiadami.
+ */
+#define GAMMA_EFFECT_MAX_PLAYERS 9
+
+/**
+ * Struktura opisująca skutki ruchu.
+ */
+typedef struct gamma_effect
+{
+  uint32_t count;
+  /**< Liczba graczy, których liczniki zmienia ruch */
+  gamma_player_effect_t players[GAMMA_EFFECT_MAX_PLAYERS];
+  /**< Zmiany liczników graczy, jako pierwsza zmiana liczników gracza
+  wykonującego ruch */
+} gamma_effect_t;
+
+/**
+ * Struktura opisująca stan przeglądania wolnych pól przyległych do pól
+ * gracza.
+ */
+typedef struct gamma_adjacent_iterator
+{
+  gamma_t *g;
+  /**< Wskaźnik na przeglądaną grę */
+  uint32_t player;
+  /**< Numer gracza */
+  uint64_t index;
+  /**< Numer kolejnego pola do odwiedzenia */
+} gamma_adjacent_iterator_t;
+
+/**
+ * Struktura opisująca obszar gracza.
+ */
+typedef struct gamma_area
+{
+  uint64_t size;
+  /**< Liczba pól obszaru */
+  uint32_t min_x;
+  /**< Najmniejszy numer kolumny pola obszaru */
+  uint32_t min_y;
+  /**< Najmniejszy numer wiersza pola obszaru */
+  uint32_t max_x;
+  /**< Największy numer kolumny pola obszaru */
+  uint32_t max_y;
+  /**< Największy numer wiersza pola obszaru */
+} gamma_area_t;
+
+/**
+ * Struktura opisująca stan przeglądania obszarów gracza.
+ */
+typedef struct gamma_area_iterator
+{
+  gamma_t *g;
+  /**< Wskaźnik na przeglądaną grę */
+  uint32_t player;
+  /**< Numer gracza */
+  uint64_t index;
+  /**< Numer kolejnego obszaru do odwiedzenia */
+} gamma_area_iterator_t;
+
+/**
+ * Struktura przechowująca zapamiętany stan gry.
+ */
+typedef struct gamma_snapshot gamma_snapshot_t;
+
+/**
+ * Kształt sąsiedztwa pól planszy.
+ */
+typedef enum gamma_topology
+{
+  GAMMA_TOPOLOGY_SQUARE,
+  /**< Plansza z pól kwadratowych: sąsiadami pola (@p x, @p y) są pola
+  (@p x ± 1, @p y) i (@p x, @p y ± 1) */
+  GAMMA_TOPOLOGY_HEX,
+  /**< Plansza w kształcie rombu z pól sześciokątnych: sąsiadami pola
+  (@p x, @p y) są dodatkowo pola (@p x + 1, @p y - 1)
+  i (@p x - 1, @p y + 1) */
+  GAMMA_TOPOLOGY_SQUARE8
+  /**< Plansza z pól kwadratowych, na której pola stykające się rogami także
+  są sąsiadami: sąsiadami pola (@p x, @p y) są pola (@p x + dx, @p y + dy)
+  dla dx, dy ∈ {-1, 0, 1} niebędących jednocześnie zerami */
+} gamma_topology_t;
+
+/**
+ * Struktura opisująca dodatkowe opcje tworzonej gry.
+ */
+typedef struct gamma_options
+{
+  bool huge_pages;
+  /**< Czy tablice gry mają zostać umieszczone w pamięci odwzorowanej
+  z prośbą o strony rozmiaru 2 MB; gdy system tego nie umożliwia, pamięć
+  przydzielana jest zwyczajnie */
+  void *storage;
+  /**< Obszar pamięci przydzielony przez wywołującego, na przykład na stosie
+  lub w puli gier, w którym zostanie umieszczona gra, lub NULL, gdy pamięć
+  ma przydzielić biblioteka. Obszar musi być wyrównany do
+  @p _Alignof(max_align_t) i mieć co najmniej @p storage_size bajtów */
+  size_t storage_size;
+  /**< Rozmiar obszaru @p storage w bajtach, nie mniejszy od wartości
+  funkcji @ref gamma_storage_size */
+  void *scratch;
+  /**< Obszar pamięci przydzielony przez wywołującego, w którym gra
+  przechowuje stosy i tablicę odwiedzin przeszukiwań obszarów przy złotych
+  ruchach, lub NULL, gdy pamięć tę przydziela biblioteka przy pierwszym
+  przeszukiwaniu. Jeden obszar może być wspólny dla wielu gier, o ile żadne
+  dwie z nich nie są używane równocześnie, na przykład dla wszystkich gier
+  jednego wątku. Obszar musi być wyrównany do @p _Alignof(max_align_t)
+  i mieć co najmniej @p scratch_size bajtów */
+  size_t scratch_size;
+  /**< Rozmiar obszaru @p scratch w bajtach, nie mniejszy od wartości
+  funkcji @ref gamma_scratch_size */
+  gamma_topology_t topology;
+  /**< Kształt sąsiedztwa pól; wartość zerowa oznacza planszę z pól
+  kwadratowych */
+} gamma_options_t;
+
 /** @brief Tworzy strukturę przechowującą stan gry.
  * Alokuje pamięć na nową strukturę przechowującą stan gry.
  * Inicjuje tę strukturę tak, aby reprezentowała początkowy stan gry.
@@ -32,13 +191,83 @@ typedef struct gamma gamma_t;
 gamma_t* gamma_new(uint32_t width, uint32_t height,
                    uint32_t players, uint32_t areas);
 
+/** @brief Tworzy strukturę przechowującą stan gry z dodatkowymi opcjami.
+ * Działa tak jak funkcja @ref gamma_new, przydzielając pamięć zgodnie
+ * z opcjami @p options i przyjmując podany w nich kształt sąsiedztwa pól.
+ * @param[in] width   – szerokość planszy, liczba dodatnia,
+ * @param[in] height  – wysokość planszy, liczba dodatnia,
+ * @param[in] players – liczba graczy, liczba dodatnia,
+ * @param[in] areas   – maksymalna liczba obszarów,
+ *                      jakie może zająć jeden gracz, liczba dodatnia,
+ * @param[in] options – wskaźnik na opcje gry lub NULL, gdy mają zostać
+ *                      użyte opcje domyślne.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci, obszar @p storage lub @p scratch jest za mały lub
+ * niewyrównany, lub któryś z parametrów, w tym kształt sąsiedztwa pól, jest
+ * niepoprawny.
+ */
+gamma_t* gamma_new_ex(uint32_t width, uint32_t height, uint32_t players,
+                      uint32_t areas, const gamma_options_t *options);
+
+/** @brief Podaje rozmiar obszaru pamięci potrzebnego na grę.
+ * Gra o tych parametrach umieszczona w obszarze przekazanym w opcji
+ * @p storage funkcji @ref gamma_new_ex ma w nim planszę i liczniki graczy.
+ * Gdy dodatkowo podano opcję @p scratch, ruchy, złote ruchy, ich wsady
+ * oraz funkcje @ref gamma_busy_fields,
+ * @ref gamma_free_fields, @ref gamma_areas, @ref gamma_golden_possible
+ * (przeglądająca wtedy całą planszę), @ref gamma_golden_targets,
+ * @ref gamma_hash, @ref gamma_reset i @ref gamma_restore nie przydzielają
+ * pamięci. Przydzielają ją nadal: zapisywanie ruchów do cofnięcia
+ * (@ref gamma_undo_enable), przeglądanie wolnych pól przyległych i obszarów
+ * (@ref gamma_adjacent_begin, @ref gamma_area_begin) wraz z utrzymywaniem
+ * tych zbiorów przez kolejne ruchy, funkcje @ref gamma_move_effect
+ * i @ref gamma_golden_effect, gdy muszą przeszukać obszar gracza, oraz
+ * funkcje @ref gamma_snapshot i @ref gamma_board. Rozmiar wystarcza dla
+ * każdego kształtu sąsiedztwa pól.
+ * @param[in] width   – szerokość planszy, liczba dodatnia,
+ * @param[in] height  – wysokość planszy, liczba dodatnia,
+ * @param[in] players – liczba graczy, liczba dodatnia,
+ * @param[in] areas   – maksymalna liczba obszarów,
+ *                      jakie może zająć jeden gracz, liczba dodatnia.
+ * @return Rozmiar obszaru w bajtach lub zero, gdy któryś z parametrów jest
+ * niepoprawny albo plansza lub liczba graczy są zbyt duże, by gra mogła
+ * zostać umieszczona w obszarze wywołującego.
+ */
+size_t gamma_storage_size(uint32_t width, uint32_t height, uint32_t players,
+                          uint32_t areas);
+
+/** @brief Podaje rozmiar obszaru pomocniczego przeszukiwań obszarów.
+ * Obszar tego rozmiaru, przekazany w opcji @p scratch funkcji
+ * @ref gamma_new_ex, wystarcza każdej grze na planszy o podanych
+ * wymiarach, niezależnie od liczby graczy i kształtu sąsiedztwa pól.
+ * Wspólny obszar kilku gier musi być nie mniejszy od największego z ich
+ * rozmiarów.
+ * @param[in] width   – szerokość planszy, liczba dodatnia,
+ * @param[in] height  – wysokość planszy, liczba dodatnia.
+ * @return Rozmiar obszaru w bajtach lub zero, gdy któryś z parametrów jest
+ * niepoprawny albo plansza jest zbyt duża, by gra mogła korzystać
+ * z obszaru pomocniczego.
+ */
+size_t gamma_scratch_size(uint32_t width, uint32_t height);
+
 /** @brief Usuwa strukturę przechowującą stan gry.
- * Usuwa z pamięci strukturę wskazywaną przez @p g.
+ * Usuwa z pamięci strukturę wskazywaną przez @p g. Obszarów przekazanych
+ * w opcjach @p storage i @p scratch funkcji @ref gamma_new_ex nie zwalnia.
  * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
  * @param[in] g       – wskaźnik na usuwaną strukturę.
  */
 void gamma_delete(gamma_t *g);
 
+/** @brief Przywraca początkowy stan gry.
+ * Ustawia strukturę wskazywaną przez @p g tak, aby reprezentowała początkowy
+ * stan gry o tych samych parametrach, bez ponownego przydzielania pamięci.
+ * Usuwa zapisane ruchy do cofnięcia. Nic nie robi, jeśli wskaźnik ma
+ * wartość NULL. Nie może być wywoływana równolegle z funkcjami odczytu
+ * stanu gry (patrz @ref gamma_board).
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ */
+void gamma_reset(gamma_t *g);
+
 /** @brief Wykonuje ruch.
  * Ustawia pionek gracza @p player na polu (@p x, @p y).
  * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
@@ -69,8 +298,38 @@ bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
  */
 bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
 
+/** @brief Wykonuje wsad ruchów.
+ * Wykonuje kolejno ruchy z tablicy @p moves, tak jak kolejne wywołania
+ * funkcji @ref gamma_move, w jednej pętli.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] moves   – tablica ruchów, może być NULL, gdy @p n jest zerem,
+ * @param[in] n       – liczba ruchów,
+ * @param[out] results – tablica rozmiaru @p n, do której trafiają wyniki
+ *                      kolejnych ruchów, lub NULL.
+ * @return Liczba wykonanych ruchów lub zero, gdy któryś ze wskaźników
+ * @p g, @p moves ma wartość NULL.
+ */
+size_t gamma_move_batch(gamma_t *g, const gamma_move_t *moves, size_t n,
+                        bool *results);
+
+/** @brief Wykonuje wsad złotych ruchów.
+ * Wykonuje kolejno złote ruchy z tablicy @p moves, tak jak kolejne
+ * wywołania funkcji @ref gamma_golden_move, w jednej pętli.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] moves   – tablica ruchów, może być NULL, gdy @p n jest zerem,
+ * @param[in] n       – liczba ruchów,
+ * @param[out] results – tablica rozmiaru @p n, do której trafiają wyniki
+ *                      kolejnych ruchów, lub NULL.
+ * @return Liczba wykonanych ruchów lub zero, gdy któryś ze wskaźników
+ * @p g, @p moves ma wartość NULL.
+ */
+size_t gamma_golden_move_batch(gamma_t *g, const gamma_move_t *moves,
+                               size_t n, bool *results);
+
 /** @brief Podaje liczbę pól zajętych przez gracza.
  * Podaje liczbę pól zajętych przez gracza @p player.
+ * Może być wywoływana z innego wątku równolegle z ruchami wykonywanymi przez
+ * jeden wątek (patrz @ref gamma_board); nigdy nie czeka na zakończenie ruchu.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
  * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
  *                      @p players z funkcji @ref gamma_new.
@@ -82,6 +341,9 @@ uint64_t gamma_busy_fields(gamma_t *g, uint32_t player);
 /** @brief Podaje liczbę pól, jakie jeszcze gracz może zająć.
  * Podaje liczbę wolnych pól, na których w danym stanie gry gracz @p player może
  * postawić swój pionek w następnym ruchu.
+ * Może być wywoływana z innego wątku równolegle z ruchami wykonywanymi przez
+ * jeden wątek, bez blokowania go (patrz @ref gamma_board); liczniki gracza
+ * odczytuje ponownie, gdy w trakcie odczytu ruch je zmienił.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
  * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
  *                      @p players z funkcji @ref gamma_new.
@@ -90,6 +352,73 @@ uint64_t gamma_busy_fields(gamma_t *g, uint32_t player);
  */
 uint64_t gamma_free_fields(gamma_t *g, uint32_t player);
 
+/** @brief Rozpoczyna przeglądanie wolnych pól przyległych do pól gracza.
+ * Ustawia iterator @p it na początek zbioru wolnych pól sąsiadujących
+ * z polami gracza @p player. Gdy gracz osiągnął maksymalną liczbę obszarów,
+ * są to dokładnie pola, na których może postawić pionek, więc przejrzenie
+ * ich zajmuje czas proporcjonalny do liczby legalnych ruchów, a nie do
+ * rozmiaru planszy. Zbiory tworzone są przy pierwszym wywołaniu funkcji,
+ * a następnie aktualizowane przez każdy ruch.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] it     – wskaźnik na iterator.
+ * @return Wartość @p true, jeśli iterator został ustawiony, a @p false,
+ * gdy któryś z parametrów jest niepoprawny lub nie udało się zaalokować
+ * pamięci.
+ */
+bool gamma_adjacent_begin(gamma_t *g, uint32_t player,
+                          gamma_adjacent_iterator_t *it);
+
+/** @brief Podaje kolejne wolne pole przyległe do pól gracza.
+ * Pola podawane są w dowolnej kolejności. Wykonanie ruchu, cofnięcie go
+ * lub przywrócenie stanu gry unieważnia iterator; przeglądanie należy
+ * wtedy rozpocząć od nowa funkcją @ref gamma_adjacent_begin.
+ * @param[in,out] it  – wskaźnik na iterator ustawiony funkcją
+ *                      @ref gamma_adjacent_begin,
+ * @param[out] field  – wskaźnik na kolejne pole.
+ * @return Wartość @p true, jeśli podano kolejne pole, a @p false, gdy
+ * przejrzano już wszystkie pola lub któryś ze wskaźników ma wartość NULL.
+ */
+bool gamma_adjacent_next(gamma_adjacent_iterator_t *it, gamma_field_t *field);
+
+/** @brief Podaje liczbę obszarów gracza.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new.
+ * @return Liczba obszarów zajętych przez gracza lub zero,
+ * jeśli któryś z parametrów jest niepoprawny.
+ */
+uint32_t gamma_areas(gamma_t *g, uint32_t player);
+
+/** @brief Rozpoczyna przeglądanie obszarów gracza.
+ * Dla każdego gracza utrzymywany jest zbiór jego obszarów wraz z ich
+ * rozmiarami i prostokątami ograniczającymi, dzięki czemu przeglądanie
+ * ich zajmuje czas proporcjonalny do liczby obszarów. Zbiory tworzone są
+ * przy pierwszym wywołaniu funkcji, a następnie aktualizowane przez każdy
+ * ruch; cofnięcie ruchu lub przywrócenie stanu gry je usuwa.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] it     – wskaźnik na iterator.
+ * @return Wartość @p true, jeśli iterator został ustawiony, a @p false,
+ * gdy któryś z parametrów jest niepoprawny lub nie udało się zaalokować
+ * pamięci.
+ */
+bool gamma_area_begin(gamma_t *g, uint32_t player, gamma_area_iterator_t *it);
+
+/** @brief Podaje kolejny obszar gracza.
+ * Obszary podawane są w dowolnej kolejności. Wykonanie ruchu, cofnięcie go
+ * lub przywrócenie stanu gry unieważnia iterator; przeglądanie należy
+ * wtedy rozpocząć od nowa funkcją @ref gamma_area_begin.
+ * @param[in,out] it  – wskaźnik na iterator ustawiony funkcją
+ *                      @ref gamma_area_begin,
+ * @param[out] area   – wskaźnik na opis kolejnego obszaru.
+ * @return Wartość @p true, jeśli podano kolejny obszar, a @p false, gdy
+ * przejrzano już wszystkie obszary lub któryś ze wskaźników ma wartość NULL.
+ */
+bool gamma_area_next(gamma_area_iterator_t *it, gamma_area_t *area);
+
 /** @brief Sprawdza, czy gracz może wykonać złoty ruch.
  * Sprawdza, czy gracz @p player jeszcze nie wykonał w tej rozgrywce złotego
  * ruchu i jest przynajmniej jedno pole, na które gracz @p player może wykonać
@@ -106,10 +435,147 @@ uint64_t gamma_free_fields(gamma_t *g, uint32_t player);
  */
 bool gamma_golden_possible(gamma_t *g, uint32_t player);
 
+/** @brief Wyznacza pola, na które gracz może wykonać złoty ruch.
+ * Umieszcza w buforze @p targets pola, na które gracz @p player może w danym
+ * stanie gry wykonać złoty ruch, uporządkowane według numeru wiersza,
+ * a następnie numeru kolumny. Wszystkie pola wyznaczane są w jednym
+ * przejściu planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] targets – bufor na pola, może być NULL, gdy @p size jest zerem,
+ * @param[in] size    – liczba pól mieszczących się w buforze @p targets.
+ * @return Liczba wszystkich pól, na które gracz może wykonać złoty ruch
+ * (do bufora trafia co najwyżej @p size pierwszych z nich) lub zero,
+ * jeśli gracz wykonał już złoty ruch lub któryś z parametrów jest niepoprawny.
+ */
+uint64_t gamma_golden_targets(gamma_t *g, uint32_t player,
+                              gamma_field_t *targets, uint64_t size);
+
+/** @brief Wyznacza skutki ruchu bez jego wykonywania.
+ * Sprawdza, czy gracz @p player może postawić pionek na polu (@p x, @p y),
+ * i wyznacza zmiany liczników graczy, jakie spowodowałby ten ruch.
+ * Nie modyfikuje stanu gry, więc może być wywoływana współbieżnie z innymi
+ * wywołaniami tej funkcji i funkcji @ref gamma_golden_effect.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new,
+ * @param[out] effect – wskaźnik na opis skutków ruchu, wypełniany, gdy ruch
+ *                      jest legalny.
+ * @return Wartość @p true, jeśli ruch jest legalny, a @p false, gdy ruch
+ * jest nielegalny, któryś z parametrów jest niepoprawny lub nie udało się
+ * zaalokować pamięci.
+ */
+bool gamma_move_effect(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                       gamma_effect_t *effect);
+
+/** @brief Wyznacza skutki złotego ruchu bez jego wykonywania.
+ * Sprawdza, czy gracz @p player może wykonać złoty ruch na pole
+ * (@p x, @p y), i wyznacza zmiany liczników obu graczy, jakie spowodowałby
+ * ten ruch. Nie modyfikuje stanu gry, więc może być wywoływana współbieżnie
+ * z innymi wywołaniami tej funkcji i funkcji @ref gamma_move_effect.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new,
+ * @param[out] effect – wskaźnik na opis skutków ruchu, wypełniany, gdy ruch
+ *                      jest legalny.
+ * @return Wartość @p true, jeśli złoty ruch jest legalny, a @p false, gdy
+ * gracz wykorzystał już swój złoty ruch, ruch jest nielegalny, któryś
+ * z parametrów jest niepoprawny lub nie udało się zaalokować pamięci.
+ */
+bool gamma_golden_effect(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                         gamma_effect_t *effect);
+
+/** @brief Zapamiętuje stan gry.
+ * Alokuje w pamięci jeden ciągły blok, do którego kopiuje cały stan gry
+ * @p g: planszę, powiązania między polami obszarów, liczniki graczy
+ * i informację o wykorzystanych złotych ruchach. Zapamiętany stan można
+ * wielokrotnie przywracać funkcją @ref gamma_restore.
+ * Funkcja wywołująca musi zwolnić blok funkcją @ref gamma_snapshot_delete.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na zapamiętany stan gry lub NULL, gdy nie udało się
+ * zaalokować pamięci lub @p g ma wartość NULL.
+ */
+gamma_snapshot_t* gamma_snapshot(gamma_t *g);
+
+/** @brief Przywraca zapamiętany stan gry.
+ * Kopiuje do struktury @p g stan gry zapamiętany funkcją
+ * @ref gamma_snapshot. Stan musi pochodzić z gry o tych samych parametrach
+ * i kształcie sąsiedztwa pól co gra @p g (np. z niej samej). Nie może być
+ * wywoływana równolegle z funkcjami odczytu stanu gry (patrz
+ * @ref gamma_board).
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] snapshot – wskaźnik na zapamiętany stan gry.
+ * @return Wartość @p true, jeśli stan został przywrócony, a @p false,
+ * gdy któryś ze wskaźników ma wartość NULL lub stan pochodzi z gry
+ * o innych parametrach.
+ */
+bool gamma_restore(gamma_t *g, const gamma_snapshot_t *snapshot);
+
+/** @brief Usuwa zapamiętany stan gry.
+ * Nic nie robi, jeśli wskaźnik ma wartość NULL.
+ * @param[in] snapshot – wskaźnik na usuwany stan gry.
+ */
+void gamma_snapshot_delete(gamma_snapshot_t *snapshot);
+
+/** @brief Włącza lub wyłącza zapisywanie ruchów do cofnięcia.
+ * Gdy zapisywanie jest włączone, każdy wykonany ruch (zwykły lub złoty)
+ * zapisuje w dzienniku poprzednie wartości zmienionych przez siebie
+ * elementów stanu gry. Wyłączenie zapisywania usuwa dziennik.
+ * Domyślnie zapisywanie jest wyłączone.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] enabled – wartość @p true, aby włączyć zapisywanie,
+ *                      a @p false, aby je wyłączyć.
+ */
+void gamma_undo_enable(gamma_t *g, bool enabled);
+
+/** @brief Cofa ostatni zapisany ruch.
+ * Przywraca stan gry sprzed ostatniego ruchu wykonanego przy włączonym
+ * zapisywaniu ruchów, w czasie proporcjonalnym do liczby zmian
+ * wykonanych przez ten ruch. Przywrócenie stanu funkcją
+ * @ref gamma_restore oraz brak pamięci na dziennik usuwają zapisane ruchy.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeśli ruch został cofnięty, a @p false,
+ * gdy nie ma zapisanego ruchu do cofnięcia lub @p g ma wartość NULL.
+ */
+bool gamma_undo(gamma_t *g);
+
+/** @brief Podaje skrót stanu gry.
+ * Podaje 64-bitowy skrót Zobrista stanu gry, obejmujący zawartość wszystkich
+ * pól planszy oraz informację, którzy gracze wykonali już złoty ruch.
+ * Skrót aktualizowany jest w czasie stałym przez każdy ruch (zwykły
+ * i złoty) oraz jego cofnięcie, a jednakowe stany gier o tych samych
+ * parametrach mają jednakowe skróty, co pozwala użyć go jako klucza
+ * w tablicy transpozycji.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Skrót stanu gry lub zero, gdy @p g ma wartość NULL.
+ */
+uint64_t gamma_hash(gamma_t *g);
+
 /** @brief Daje napis opisujący stan planszy.
  * Alokuje w pamięci bufor, w którym umieszcza napis zawierający tekstowy
  * opis aktualnego stanu planszy. Przykład znajduje się w pliku gamma_test.c.
  * Funkcja wywołująca musi zwolnić ten bufor.
+ * Funkcje @ref gamma_board, @ref gamma_busy_fields i @ref gamma_free_fields
+ * mogą być wywoływane przez dowolną liczbę wątków równolegle z jednym wątkiem
+ * wykonującym ruchy (również złote, wsadowe i ich cofanie). Odczyt nie
+ * blokuje ruchów. Plansza odczytywana jest wiersz po wierszu: każdy wiersz
+ * napisu odpowiada stanowi tego wiersza planszy pomiędzy ruchami, a gdy
+ * ruch zmienił go w trakcie odczytu, odczytywany jest ponownie tylko ten
+ * wiersz. Różne wiersze mogą więc pochodzić z różnych chwil gry; spójny
+ * obraz całej planszy daje wywołanie bez równoległych ruchów. Dotyczy to
+ * tylko gier, dla których funkcja @ref gamma_storage_size daje niezerowy
+ * rozmiar; w pozostałych grach plansza i tablice graczy są przydzielane na
+ * nowo w trakcie ruchów. Funkcje @ref gamma_reset, @ref gamma_restore
+ * i @ref gamma_delete wymagają, by żaden wątek nie odczytywał gry.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
  * @return Wskaźnik na zaalokowany bufor zawierający napis opisujący stan
  * planszy lub NULL, jeśli nie udało się zaalokować pamięci.
@@ -137,4 +603,13 @@ uint32_t get_board_height(gamma_t *g);
  */
 uint32_t get_players_count(gamma_t *g);
 
+#ifdef GAMMA_COUNT_READS
+/** Liczba odczytów pól i rodziców pól planszy wykonanych przez wszystkie
+ * gry, dostępna tylko w wersji skompilowanej z makrem @p GAMMA_COUNT_READS,
+ * na potrzeby pomiarów; zliczanie nie jest bezpieczne przy równoległych
+ * odczytach stanu gry.
+ */
+extern uint64_t gamma_read_count;
+#endif
+
 #endif /* GAMMA_H */
@@ -17,6 +17,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef __STDC_NO_THREADS__
+#include <stdatomic.h>
+#include <threads.h>
+#endif
+
 /**
  * Tak ma wyglądać plansza po wykonaniu wszystkich testów.
  */
@@ -32,6 +37,58 @@ static const char board[] =
   "1221......\n"
   "1.........\n";
 
+#ifndef __STDC_NO_THREADS__
+/**
+ * Bok planszy w teście odczytu równoległego z ruchami.
+ */
+#define STRESS_SIDE 128
+
+/**
+ * Liczba wątków odczytujących grę w teście odczytu równoległego z ruchami.
+ */
+#define STRESS_READERS 3
+
+/**
+ * Gra, w której jeden wątek wykonuje ruchy, a pozostałe ją odczytują.
+ */
+static gamma_t *shared;
+
+/**
+ * Czy wątek wykonujący ruchy na grze @ref shared zakończył już pracę.
+ */
+static atomic_bool moves_done;
+
+/** @brief Odczytuje grę @ref shared aż do zakończenia ruchów.
+ * Plansza zapełniana jest wierszami od dołu i od lewej strony, a złote ruchy
+ * zmieniają tylko właściciela zajętego pola, więc w każdym wierszu napisu
+ * po pierwszym wolnym polu są już tylko wolne pola.
+ * @param[in] arg – nieużywany.
+ * @return Zero.
+ */
+static int read_shared(void *arg) {
+  (void)arg;
+  bool last = false;
+  while (!last) {
+    last = atomic_load(&moves_done);
+    char *p = gamma_board(shared);
+    assert(p != NULL);
+    bool free_seen = false;
+    for (const char *c = p; *c != '\0'; c++) {
+      if (*c == '\n')
+        free_seen = false;
+      else if (*c == '.')
+        free_seen = true;
+      else
+        assert(!free_seen);
+    }
+    free(p);
+    assert(gamma_busy_fields(shared, 1) <= STRESS_SIDE * STRESS_SIDE);
+    assert(gamma_free_fields(shared, 1) <= STRESS_SIDE * STRESS_SIDE);
+  }
+  return 0;
+}
+#endif
+
 /** @brief Testuje silnik gry gamma.
  * Przeprowadza przykładowe testy silnika gry gamma.
  * @return Zero, gdy wszystkie testy przebiegły poprawnie,
@@ -61,6 +118,15 @@ int main() {
   assert(gamma_move(g, 1, 0, 9));
   assert(!gamma_move(g, 1, 5, 5));
   assert(gamma_free_fields(g, 1) == 6);
+  gamma_adjacent_iterator_t it;
+  gamma_field_t f;
+  uint64_t adjacent = 0;
+  assert(gamma_adjacent_begin(g, 1, &it));
+  while (gamma_adjacent_next(&it, &f)) {
+    assert(f.x <= 1);
+    adjacent++;
+  }
+  assert(adjacent == 6);
   assert(gamma_move(g, 1, 0, 1));
   assert(gamma_free_fields(g, 1) == 95);
   assert(gamma_move(g, 1, 5, 5));
@@ -73,6 +139,28 @@ int main() {
   assert(gamma_free_fields(g, 2) == 92);
   assert(!gamma_move(g, 2, 0, 1));
   assert(gamma_golden_possible(g, 2));
+  assert(gamma_golden_targets(g, 2, NULL, 0) == 4);
+  gamma_effect_t e;
+  assert(gamma_golden_effect(g, 2, 5, 5, &e));
+  assert(e.count == 2 && e.players[1].player == 1 && e.players[1].areas == -1);
+  assert(!gamma_golden_effect(g, 2, 0, 1, &e));
+  gamma_snapshot_t *s = gamma_snapshot(g);
+  assert(s != NULL);
+  assert(gamma_golden_move(g, 2, 5, 5));
+  assert(gamma_restore(g, s));
+  assert(gamma_busy_fields(g, 1) == 5);
+  assert(gamma_golden_possible(g, 2));
+  gamma_snapshot_delete(s);
+  gamma_undo_enable(g, true);
+  uint64_t hash = gamma_hash(g);
+  assert(gamma_golden_move(g, 2, 5, 5));
+  assert(gamma_hash(g) != hash);
+  assert(gamma_undo(g));
+  assert(gamma_hash(g) == hash);
+  assert(!gamma_undo(g));
+  assert(gamma_busy_fields(g, 1) == 5);
+  assert(gamma_golden_possible(g, 2));
+  gamma_undo_enable(g, false);
   assert(!gamma_golden_move(g, 2, 0, 1));
   assert(gamma_golden_move(g, 2, 5, 5));
   assert(!gamma_golden_possible(g, 2));
@@ -94,5 +182,213 @@ int main() {
   free(p);
 
   gamma_delete(g);
+
+  g = gamma_new(3, 3, 2, 1);
+  gamma_move_t moves[] = {{1, 0, 0}, {2, 1, 0}, {1, 2, 2}, {1, 1, 1}};
+  bool results[4];
+  assert(gamma_move_batch(g, moves, 4, results) == 2);
+  assert(results[0] && results[1] && !results[2] && !results[3]);
+  gamma_move_t golden[] = {{1, 1, 0}};
+  assert(gamma_golden_move_batch(g, golden, 1, NULL) == 1);
+  assert(gamma_busy_fields(g, 1) == 2);
+  gamma_reset(g);
+  assert(gamma_busy_fields(g, 1) == 0 && gamma_hash(g) == 0);
+  assert(gamma_move_batch(g, moves, 4, results) == 2);
+  assert(gamma_golden_move_batch(g, golden, 1, NULL) == 1);
+  gamma_area_iterator_t ait;
+  gamma_area_t area;
+  assert(gamma_areas(g, 1) == 1);
+  assert(gamma_area_begin(g, 1, &ait));
+  assert(gamma_area_next(&ait, &area));
+  assert(area.size == 2 && area.min_x == 0 && area.max_x == 1);
+  assert(!gamma_area_next(&ait, &area));
+  assert(gamma_move(g, 1, 2, 0));
+  assert(gamma_area_begin(g, 1, &ait));
+  assert(gamma_area_next(&ait, &area));
+  assert(area.size == 3 && area.max_x == 2 && area.max_y == 0);
+  gamma_delete(g);
+
+  g = gamma_new(20, 20, 2, 400);
+  gamma_move_t long_batch[400];
+  bool long_results[400];
+  for (uint32_t i = 0; i < 400; i++) {
+    long_batch[i].player = 1 + i % 2;
+    long_batch[i].x = i % 20;
+    long_batch[i].y = i / 20;
+  }
+  long_batch[3].x = 20;
+  long_batch[300].player = 3;
+  long_batch[301].y = 20;
+  assert(gamma_move_batch(g, long_batch, 400, long_results) == 397);
+  assert(!long_results[3] && !long_results[300] && !long_results[301]);
+  assert(long_results[2] && long_results[4] && long_results[302]);
+  assert(gamma_free_fields(g, 1) == 3);
+  gamma_delete(g);
+
+  g = gamma_new(3, 3, 2, 1);
+  assert(gamma_move(g, 2, 2, 2));
+  assert(gamma_move(g, 1, 0, 0));
+  assert(!gamma_golden_possible(g, 2));
+  assert(gamma_move(g, 1, 1, 0));
+  assert(gamma_move(g, 1, 2, 0));
+  assert(!gamma_golden_possible(g, 2));
+  assert(gamma_move(g, 1, 2, 1));
+  assert(gamma_golden_possible(g, 2));
+  assert(!gamma_golden_move(g, 2, 1, 0));
+  assert(gamma_golden_move(g, 2, 2, 1));
+  assert(gamma_golden_possible(g, 1));
+  assert(!gamma_golden_possible(g, 2));
+  gamma_delete(g);
+
+  g = gamma_new(5, 3, 2, 3);
+  assert(gamma_move(g, 1, 0, 1) && gamma_move(g, 1, 1, 1));
+  assert(gamma_move(g, 1, 2, 1) && gamma_move(g, 1, 4, 1));
+  assert(gamma_move(g, 2, 0, 0));
+  assert(gamma_golden_move(g, 2, 0, 1));
+  assert(gamma_move_effect(g, 1, 3, 1, &e));
+  assert(e.count == 1 && e.players[0].areas == -1 && e.players[0].free == 1);
+  assert(gamma_golden_effect(g, 1, 0, 1, &e));
+  assert(e.count == 2 && e.players[0].areas == 0 && e.players[0].free == 1);
+  assert(e.players[1].player == 2 && e.players[1].areas == 0);
+  assert(e.players[1].free == -1);
+  assert(gamma_move(g, 1, 3, 1));
+  assert(gamma_areas(g, 1) == 1);
+  gamma_delete(g);
+
+  g = gamma_new(1000000, 1000000, 2, 1);
+  assert(g != NULL);
+  assert(gamma_move(g, 1, 999999, 999999));
+  assert(gamma_free_fields(g, 1) == 2);
+  assert(gamma_free_fields(g, 2) == 999999999999);
+  gamma_delete(g);
+
+  g = gamma_new(2, 2, UINT32_MAX - 1, 1);
+  assert(g != NULL);
+  assert(gamma_move(g, UINT32_MAX - 1, 0, 0));
+  assert(gamma_move(g, 7, 1, 1));
+  assert(gamma_move(g, 7, 1, 0));
+  assert(gamma_busy_fields(g, 7) == 2);
+  assert(gamma_busy_fields(g, UINT32_MAX - 1) == 1);
+  assert(gamma_busy_fields(g, 12345) == 0);
+  assert(gamma_free_fields(g, 12345) == 1);
+  assert(gamma_golden_move(g, 12345, 0, 0));
+  assert(gamma_busy_fields(g, UINT32_MAX - 1) == 0);
+  gamma_delete(g);
+
+  gamma_options_t options = {.huge_pages = true};
+  g = gamma_new_ex(2000, 2000, 2, 1, &options);
+  assert(g != NULL);
+  assert(gamma_move(g, 1, 1999, 1999));
+  assert(gamma_free_fields(g, 1) == 2);
+  gamma_reset(g);
+  assert(gamma_busy_fields(g, 1) == 0);
+  assert(gamma_move(g, 1, 1999, 1999));
+  assert(gamma_free_fields(g, 1) == 2);
+  gamma_delete(g);
+
+  options = (gamma_options_t) {.topology = GAMMA_TOPOLOGY_HEX};
+  g = gamma_new_ex(3, 3, 2, 1, &options);
+  assert(g != NULL);
+  assert(gamma_move(g, 1, 0, 1));
+  assert(gamma_move(g, 1, 1, 0));
+  assert(!gamma_move(g, 1, 2, 2));
+  assert(gamma_free_fields(g, 1) == 4);
+  assert(gamma_move(g, 2, 1, 1));
+  assert(gamma_free_fields(g, 2) == 4);
+  assert(gamma_golden_possible(g, 2));
+  assert(gamma_golden_targets(g, 2, NULL, 0) == 2);
+  assert(gamma_golden_effect(g, 2, 1, 0, &e));
+  assert(e.count == 2 && e.players[0].areas == 0 && e.players[1].areas == 0);
+  assert(gamma_golden_move(g, 2, 1, 0));
+  p = gamma_board(g);
+  assert(p && strcmp(p, "...\n12.\n.2.\n") == 0);
+  free(p);
+  gamma_t *square = gamma_new(3, 3, 2, 1);
+  s = gamma_snapshot(square);
+  assert(s != NULL && !gamma_restore(g, s));
+  gamma_snapshot_delete(s);
+  gamma_delete(square);
+  gamma_delete(g);
+  options.topology = GAMMA_TOPOLOGY_SQUARE8;
+  g = gamma_new_ex(4, 4, 2, 1, &options);
+  assert(g != NULL);
+  assert(gamma_move(g, 1, 0, 0));
+  assert(gamma_move(g, 1, 1, 1));
+  assert(!gamma_move(g, 1, 3, 3));
+  assert(gamma_areas(g, 1) == 1);
+  assert(gamma_free_fields(g, 1) == 7);
+  assert(gamma_move(g, 2, 2, 2));
+  assert(gamma_free_fields(g, 2) == 7);
+  assert(gamma_golden_targets(g, 2, NULL, 0) == 1);
+  assert(gamma_golden_effect(g, 2, 1, 1, &e));
+  assert(e.count == 2 && e.players[0].areas == 0 && e.players[1].areas == 0);
+  assert(!gamma_golden_move(g, 2, 0, 0));
+  assert(gamma_golden_move(g, 2, 1, 1));
+  p = gamma_board(g);
+  assert(p && strcmp(p, "....\n..2.\n.2..\n1...\n") == 0);
+  free(p);
+  gamma_delete(g);
+  options.topology = (gamma_topology_t) 7;
+  assert(gamma_new_ex(3, 3, 2, 1, &options) == NULL);
+
+  _Alignas(max_align_t) unsigned char storage[8192];
+  _Alignas(max_align_t) unsigned char scratch[32768];
+  size_t size = gamma_storage_size(19, 19, 2, 5);
+  assert(size > 0 && size <= sizeof(storage));
+  assert(gamma_storage_size(0, 19, 2, 5) == 0);
+  size_t scratch_size = gamma_scratch_size(19, 19);
+  assert(scratch_size > 0 && scratch_size <= sizeof(scratch));
+  assert(gamma_scratch_size(19, 0) == 0);
+  options = (gamma_options_t) {.storage = storage, .storage_size = size - 1,
+                               .scratch = scratch,
+                               .scratch_size = scratch_size};
+  assert(gamma_new_ex(19, 19, 2, 5, &options) == NULL);
+  options.storage_size = size;
+  options.scratch_size = scratch_size - 1;
+  assert(gamma_new_ex(19, 19, 2, 5, &options) == NULL);
+  options.scratch_size = scratch_size;
+  g = gamma_new_ex(19, 19, 2, 5, &options);
+  assert(g == (gamma_t *) storage);
+  options.storage = NULL;
+  gamma_t *h = gamma_new_ex(10, 10, 2, 5, &options);
+  assert(h != NULL);
+  assert(gamma_move(g, 1, 18, 18));
+  assert(gamma_golden_move(g, 2, 18, 18));
+  assert(gamma_busy_fields(g, 2) == 1);
+  assert(gamma_move(g, 1, 17, 18));
+  assert(gamma_golden_possible(g, 1));
+  assert(gamma_golden_targets(g, 1, NULL, 0) == 1);
+  for (uint32_t x = 0; x < 3; x++) {
+    assert(gamma_move(g, 2, x, 0));
+    assert(gamma_move(h, 1, x, 0));
+  }
+  assert(gamma_golden_move(h, 2, 1, 0));
+  assert(gamma_areas(h, 1) == 2);
+  assert(gamma_golden_move(g, 1, 1, 0));
+  assert(gamma_areas(g, 2) == 3);
+  assert(gamma_golden_targets(h, 1, NULL, 0) == 1);
+  gamma_delete(h);
+  gamma_delete(g);
+
+#ifndef __STDC_NO_THREADS__
+  shared = gamma_new(STRESS_SIDE, STRESS_SIDE, 9, 9);
+  assert(shared != NULL);
+  thrd_t readers[STRESS_READERS];
+  for (int i = 0; i < STRESS_READERS; i++)
+    assert(thrd_create(&readers[i], read_shared, NULL) == thrd_success);
+  for (uint32_t y = 0; y < STRESS_SIDE; y++) {
+    for (uint32_t x = 0; x < STRESS_SIDE; x++)
+      assert(gamma_move(shared, 1, x, y));
+    if (y % 16 == 15)
+      assert(gamma_golden_move(shared, 2 + y / 16, y / 2, y / 2));
+  }
+  assert(gamma_golden_move(shared, 1, 63, 63));
+  atomic_store(&moves_done, true);
+  for (int i = 0; i < STRESS_READERS; i++)
+    assert(thrd_join(readers[i], NULL) == thrd_success);
+  assert(gamma_busy_fields(shared, 1) == STRESS_SIDE * STRESS_SIDE - 7);
+  assert(gamma_busy_fields(shared, 9) == 0);
+  gamma_delete(shared);
+#endif
   return 0;
 }